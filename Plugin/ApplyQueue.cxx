@@ -0,0 +1,180 @@
+#include <ApplyQueue.h>
+
+// node editor includes
+#include <Graph.h>
+#include <Node.h>
+#include <Utils.h>
+
+// qt includes
+#include <QTimer>
+
+// paraview/vtk includes
+#include <pqPipelineSource.h>
+#include <pqView.h>
+
+NE::ApplyQueue::ApplyQueue(NE::Graph& pipeline, QObject* parent) :
+    QObject(parent),
+    pipeline(pipeline)
+{
+    // a zero interval lets the event loop repaint and handle input between
+    // two updates
+    this->timer = new QTimer(this);
+    this->timer->setSingleShot(true);
+    this->timer->setInterval(0);
+    QObject::connect(
+        this->timer, &QTimer::timeout,
+        this, &ApplyQueue::run
+    );
+}
+
+NE::ApplyQueue::~ApplyQueue(){
+}
+
+int NE::ApplyQueue::enqueue(const std::vector<int>& sources, const std::vector<int>& views){
+    if(!this->running){
+        // clear the states of the previous Apply
+        for(auto id : this->done)
+            this->setState(id, 0);
+        this->done.clear();
+    }
+
+    int nQueued = 0;
+    for(auto id : sources){
+        if(!this->queued.insert(id).second)
+            continue;
+        this->sources.push_back(id);
+        this->setState(id, 1);
+        nQueued++;
+    }
+
+    // new nodes may be upstream of pending ones, so the merged queue is
+    // ordered again
+    if(this->running && nQueued>0){
+        const std::unordered_set<int> pending(this->sources.begin(), this->sources.end());
+        this->sources.clear();
+        for(auto id : this->pipeline.getDownstream({pending.begin(), pending.end()}))
+            if(pending.count(id))
+                this->sources.push_back(id);
+    }
+    for(auto id : views){
+        if(!this->queued.insert(id).second)
+            continue;
+        this->views.push_back(id);
+        this->setState(id, 1);
+        nQueued++;
+    }
+
+    if(this->running || nQueued<1)
+        return nQueued;
+
+    this->running = true;
+    emit this->started();
+    this->timer->start();
+
+    return nQueued;
+}
+
+int NE::ApplyQueue::cancel(){
+    if(!this->running)
+        return 0;
+
+    NE::log("Apply Cancelled: "+std::to_string(this->sources.size()+this->views.size())+" pending");
+
+    this->timer->stop();
+
+    // the announced update has not been executed yet
+    if(this->current>=0){
+        if(this->pipeline.getKind(this->current)==NE::Graph::VIEW)
+            this->views.push_front(this->current);
+        else
+            this->sources.push_front(this->current);
+    }
+
+    for(auto id : this->sources){
+        this->setState(id, 0);
+        if(auto node = this->pipeline.getNode(id))
+            node->getProxy()->setModifiedState(pqProxy::ModifiedState::MODIFIED);
+    }
+    for(auto id : this->views)
+        this->setState(id, 0);
+
+    this->sources.clear();
+    this->views.clear();
+    this->queued.clear();
+    this->current = -1;
+    this->running = false;
+    this->generation++;
+
+    emit this->finished(true);
+
+    return 1;
+}
+
+int NE::ApplyQueue::run(){
+    // execute the update that was announced in the previous pass
+    if(this->current>=0){
+        const int id = this->current;
+        this->current = -1;
+        this->queued.erase(id);
+
+        auto node = this->pipeline.getNode(id);
+        if(!node)
+            return this->schedule();
+
+        // producers were updated before, so this only measures the node itself
+        const unsigned int generation = this->generation;
+        const double t0 = NE::getTimeStamp();
+        if(auto proxyAsView = dynamic_cast<pqView*>(node->getProxy())){
+            NE::log("Update View: "+NE::getLabel(proxyAsView));
+            proxyAsView->render();
+        } else if(auto proxyAsSource = dynamic_cast<pqPipelineSource*>(node->getProxy())){
+            NE::log("Update Pipeline: "+NE::getLabel(proxyAsSource));
+            proxyAsSource->updatePipeline();
+        }
+        const double duration = NE::getTimeStamp()-t0;
+
+        // progress events may have been processed during the update, and the
+        // queue may have been cancelled and finished in the meantime
+        if(this->generation!=generation)
+            return 0;
+
+        this->setState(id, 3);
+        this->done.push_back(id);
+        emit this->nodeUpdated(id, duration);
+    }
+
+    return this->schedule();
+}
+
+int NE::ApplyQueue::schedule(){
+    // mark the next update as running, so that its state is painted before
+    // it blocks the event loop
+    while(this->current<0 && (!this->sources.empty() || !this->views.empty())){
+        auto& queue = this->sources.empty() ? this->views : this->sources;
+        const int id = queue.front();
+        queue.pop_front();
+        if(!this->pipeline.getNode(id)){
+            this->queued.erase(id);
+            continue;
+        }
+        this->current = id;
+        this->setState(id, 2);
+    }
+
+    if(this->current>=0){
+        this->timer->start();
+        return 1;
+    }
+
+    this->running = false;
+    emit this->finished(false);
+
+    return 0;
+}
+
+int NE::ApplyQueue::setState(int id, int state){
+    auto node = this->pipeline.getNode(id);
+    if(!node)
+        return 0;
+    return node->setApplyState(state);
+}
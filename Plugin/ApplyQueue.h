@@ -0,0 +1,83 @@
+#pragma once
+
+// qt includes
+#include <QObject>
+
+// std includes
+#include <deque>
+#include <unordered_set>
+#include <vector>
+
+// forward declarations
+class QTimer;
+
+namespace NE {
+    class Graph;
+}
+
+namespace NE {
+
+    /// This class updates the pipelines of an Apply one node per pass of the
+    /// event loop, followed by the views that show their outputs, so that the
+    /// editor stays responsive between two updates and the remaining updates
+    /// can be cancelled. Every queued node shows whether its update is
+    /// pending, running or done.
+    ///
+    /// Updates are executed on the GUI thread one after another, also in
+    /// built-in sessions, since the server manager and the VTK pipelines it
+    /// drives must not be accessed from other threads. An update may process
+    /// events through the progress handler, so a cancel can arrive while it
+    /// runs.
+    class ApplyQueue : public QObject {
+        Q_OBJECT
+
+        public:
+            ApplyQueue(NE::Graph& pipeline, QObject* parent=nullptr);
+            ~ApplyQueue();
+
+            /// Queues sources and filters in topological order and the views
+            /// that have to be rendered afterwards. Nodes that are already
+            /// queued are skipped, and pending sources and filters are
+            /// ordered again together with the new ones.
+            int enqueue(const std::vector<int>& sources, const std::vector<int>& views);
+
+            bool isRunning(){return this->running;};
+
+        public slots:
+            /// Drops all pending updates. Cancelled sources and filters are
+            /// marked as modified, so that the next Apply updates them.
+            int cancel();
+
+        signals:
+            void started();
+            void finished(bool cancelled);
+
+            /// Emitted after the pipeline of a source or filter was updated
+            /// or a view was rendered, with the wall time in seconds.
+            void nodeUpdated(int id, double duration);
+
+        protected slots:
+            int run();
+
+        private:
+            /// Announces the next update or finishes the queue.
+            int schedule();
+
+            int setState(int id, int state);
+
+            NE::Graph& pipeline;
+            QTimer* timer;
+
+            std::deque<int> sources;
+            std::deque<int> views;
+            std::unordered_set<int> queued;
+            std::vector<int> done;
+
+            int current{-1};
+            bool running{false};
+
+            // incremented by every cancel, so that an update that returns
+            // after a cancel does not continue the cancelled queue
+            unsigned int generation{0};
+    };
+}
@@ -0,0 +1,107 @@
+#include <ChangeJournal.h>
+
+// node editor includes
+#include <Utils.h>
+
+// qt includes
+#include <QTimer>
+
+// paraview/vtk includes
+#include <pqPipelineSource.h>
+#include <pqView.h>
+
+bool NE::ChangeJournal::Changes::empty() const {
+    return this->addedSources.empty()
+        && this->addedViews.empty()
+        && this->rewiredConsumers.empty()
+        && this->changedViews.empty()
+        && !this->selectionChanged
+        && !this->activeViewChanged;
+}
+
+NE::ChangeJournal::ChangeJournal(QObject* parent) :
+    QObject(parent)
+{
+    // a zero interval fires once the event loop is idle again
+    this->timer = new QTimer(this);
+    this->timer->setSingleShot(true);
+    this->timer->setInterval(0);
+    QObject::connect(
+        this->timer, &QTimer::timeout,
+        this, &ChangeJournal::flush
+    );
+}
+
+NE::ChangeJournal::~ChangeJournal(){
+}
+
+int NE::ChangeJournal::addSource(pqPipelineSource* proxy){
+    const int id = NE::getID(proxy);
+    this->changes.addedSources[id] = proxy;
+    this->changes.rewiredConsumers[id] = proxy;
+    return this->schedule();
+}
+
+int NE::ChangeJournal::addView(pqView* proxy){
+    const int id = NE::getID(proxy);
+    this->changes.addedViews[id] = proxy;
+    this->changes.changedViews[id] = proxy;
+    this->changes.activeViewChanged = true;
+    return this->schedule();
+}
+
+int NE::ChangeJournal::rewireConsumer(pqPipelineSource* proxy){
+    this->changes.rewiredConsumers[NE::getID(proxy)] = proxy;
+    return this->schedule();
+}
+
+int NE::ChangeJournal::changeVisibility(pqView* proxy){
+    this->changes.changedViews[NE::getID(proxy)] = proxy;
+    return this->schedule();
+}
+
+int NE::ChangeJournal::changeSelection(){
+    this->changes.selectionChanged = true;
+    return this->schedule();
+}
+
+int NE::ChangeJournal::changeActiveView(){
+    this->changes.activeViewChanged = true;
+    return this->schedule();
+}
+
+int NE::ChangeJournal::remove(pqProxy* proxy){
+    const int id = NE::getID(proxy);
+    this->changes.addedSources.erase(id);
+    this->changes.addedViews.erase(id);
+    this->changes.rewiredConsumers.erase(id);
+    this->changes.changedViews.erase(id);
+    return 1;
+}
+
+int NE::ChangeJournal::flush(){
+    this->timer->stop();
+    if(this->changes.empty())
+        return 0;
+
+    // the handlers may record new changes for the next pass
+    Changes changes;
+    std::swap(changes, this->changes);
+
+    NE::log(
+        "Journal: "
+        + std::to_string(changes.addedSources.size()+changes.addedViews.size()) + " nodes, "
+        + std::to_string(changes.rewiredConsumers.size()) + " consumers, "
+        + std::to_string(changes.changedViews.size()) + " views"
+    );
+
+    emit this->changesReady(changes);
+
+    return 1;
+}
+
+int NE::ChangeJournal::schedule(){
+    if(!this->timer->isActive())
+        this->timer->start();
+    return 1;
+}
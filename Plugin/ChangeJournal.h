@@ -0,0 +1,82 @@
+#pragma once
+
+// qt includes
+#include <QObject>
+
+// std includes
+#include <map>
+#include <vector>
+
+// forward declarations
+class QTimer;
+
+class pqProxy;
+class pqPipelineSource;
+class pqView;
+
+namespace NE {
+
+    /// This class records the structural signals of the server manager
+    /// (created proxies, changed connections, changed visibilities, changed
+    /// selections) and reports their net effect once per pass of the event
+    /// loop. Creating hundreds of filters from a script or loading a state
+    /// therefore creates every node once and rebuilds the edges of every
+    /// consumer and view once, instead of once per signal.
+    ///
+    /// Removed proxies are not recorded, since their nodes have to be
+    /// deleted immediately; instead, all pending entries of a removed proxy
+    /// are dropped.
+    class ChangeJournal : public QObject {
+        Q_OBJECT
+
+        public:
+            /// The net changes of one event loop pass. Proxies are keyed by
+            /// their global identifiers, so they are processed in the order
+            /// in which they were created.
+            struct Changes {
+                std::map<int,pqPipelineSource*> addedSources;
+                std::map<int,pqView*> addedViews;
+                std::map<int,pqPipelineSource*> rewiredConsumers;
+                std::map<int,pqView*> changedViews;
+                bool selectionChanged{false};
+                bool activeViewChanged{false};
+
+                bool empty() const;
+            };
+
+            ChangeJournal(QObject* parent=nullptr);
+            ~ChangeJournal();
+
+        public slots:
+            /// Records a new source or filter. Its incoming edges are
+            /// rebuilt as well.
+            int addSource(pqPipelineSource* proxy);
+
+            /// Records a new view. Its visibility edges are rebuilt as well.
+            int addView(pqView* proxy);
+
+            /// Records that the inputs of a filter changed.
+            int rewireConsumer(pqPipelineSource* proxy);
+
+            /// Records that the visible representations of a view changed.
+            int changeVisibility(pqView* proxy);
+
+            int changeSelection();
+            int changeActiveView();
+
+            /// Drops all pending entries of a removed proxy.
+            int remove(pqProxy* proxy);
+
+            /// Emits the recorded changes immediately and clears the journal.
+            int flush();
+
+        signals:
+            void changesReady(const NE::ChangeJournal::Changes& changes);
+
+        private:
+            int schedule();
+
+            Changes changes;
+            QTimer* timer;
+    };
+}
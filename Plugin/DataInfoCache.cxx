@@ -0,0 +1,82 @@
+#include <DataInfoCache.h>
+
+// node editor includes
+#include <Utils.h>
+
+// qt includes
+#include <QTimer>
+
+// paraview/vtk includes
+#include <pqOutputPort.h>
+#include <pqPipelineSource.h>
+#include <vtkPVDataInformation.h>
+
+
+NE::DataInfoCache::DataInfoCache(QObject* parent) :
+    QObject(parent)
+{
+    this->timer = new QTimer(this);
+    this->timer->setSingleShot(true);
+    this->timer->setInterval(0);
+    QObject::connect(
+        this->timer, &QTimer::timeout,
+        this, &DataInfoCache::fetch
+    );
+}
+
+NE::DataInfoCache::~DataInfoCache(){
+}
+
+const NE::DataInfoCache::Info* NE::DataInfoCache::get(pqOutputPort* port){
+    const Key key(NE::getID(port->getSource()), port->getPortNumber());
+
+    auto it = this->infos.find(key);
+    if(it!=this->infos.end())
+        return &it->second;
+
+    this->requests[key] = port;
+    if(!this->timer->isActive())
+        this->timer->start();
+
+    return nullptr;
+}
+
+int NE::DataInfoCache::invalidate(pqPipelineSource* source){
+    const int id = NE::getID(source);
+    this->infos.erase(
+        this->infos.lower_bound( Key(id, 0) ),
+        this->infos.lower_bound( Key(id+1, 0) )
+    );
+    return 1;
+}
+
+int NE::DataInfoCache::fetch(){
+    // every fetch may be a round trip to the server, so only one port is
+    // fetched per pass and the event loop runs in between
+    while(!this->requests.empty()){
+        const auto key = this->requests.begin()->first;
+        auto port = this->requests.begin()->second;
+        this->requests.erase(this->requests.begin());
+        if(!port)
+            continue;
+
+        Info info;
+        if(auto dataInfo = port->getDataInformation()){
+            info.cells = dataInfo->GetNumberOfCells();
+            info.points = dataInfo->GetNumberOfPoints();
+            info.bytes = 1024.0*dataInfo->GetMemorySize();
+        }
+        this->infos[key] = info;
+
+        NE::log("Fetched Data Information: "+NE::getLabel(port->getSource())+" "+std::to_string(key.second));
+
+        // handlers may request more information
+        emit this->infoUpdated(port->getSource());
+        break;
+    }
+
+    if(!this->requests.empty() && !this->timer->isActive())
+        this->timer->start();
+
+    return 1;
+}
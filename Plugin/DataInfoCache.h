@@ -0,0 +1,61 @@
+#pragma once
+
+// qt includes
+#include <QObject>
+#include <QPointer>
+
+// std includes
+#include <map>
+#include <utility>
+#include <vector>
+
+// forward declarations
+class QTimer;
+
+class pqOutputPort;
+class pqPipelineSource;
+
+namespace NE {
+
+    /// This class caches the number of cells and points and the memory size
+    /// of the data of every output port. Requests for missing entries are
+    /// queued and fetched one port per pass of the event loop, so painting
+    /// and hovering never wait for the server, and a burst of requests does
+    /// not block the editor for all of their round trips at once. A single
+    /// fetch is still synchronous. Entries of a source are only dropped when
+    /// its pipeline was executed again.
+    class DataInfoCache : public QObject {
+        Q_OBJECT
+
+        public:
+            struct Info {
+                double cells{0};
+                double points{0};
+                double bytes{0};
+            };
+
+            DataInfoCache(QObject* parent=nullptr);
+            ~DataInfoCache();
+
+            /// Returns the cached information of a port, or nullptr if it is
+            /// not available yet, in which case it is requested.
+            const Info* get(pqOutputPort* port);
+
+            /// Drops the entries of all output ports of a source.
+            int invalidate(pqPipelineSource* source);
+
+        signals:
+            /// Emitted once requested information of a source is available.
+            void infoUpdated(pqPipelineSource* source);
+
+        protected slots:
+            int fetch();
+
+        private:
+            using Key = std::pair<int,int>;
+
+            std::map<Key,Info> infos;
+            std::map<Key,QPointer<pqOutputPort>> requests;
+            QTimer* timer;
+    };
+}
@@ -5,76 +5,104 @@
 #include <Node.h>
 #include <Port.h>
 #include <Scene.h>
-
-// paraview/vtk includes
-#include <pqPipelineSource.h>
-#include <vtkSMProxy.h>
+#include <EdgeLayer.h>
 
 // qt includes
-#include <QPainter>
-#include <QStyleOptionGraphicsItem>
-#include <QGraphicsScene>
-#include <QApplication>
+#include <QGraphicsEllipseItem>
+#include <QPainterPathStroker>
 
 // std includes
+#include <algorithm>
 #include <sstream>
 
 NE::Edge::Edge(
-    QGraphicsScene* scene,
+    NE::Scene* scene,
     Node* producer,
     int producerOutputPortIdx,
     Node* consumer,
     int consumerInputPortIdx,
-    int type,
-    QGraphicsItem *parent
+    int type
 ) :
-    QObject(),
-    QGraphicsPathItem(parent),
     scene(scene),
+    type(type),
     producer(producer),
     producerOutputPortIdx(producerOutputPortIdx),
     consumer(consumer),
-    consumerInputPortIdx(consumerInputPortIdx),
-    type(type)
+    consumerInputPortIdx(consumerInputPortIdx)
 {
     NE::log("  +Edge: "+ this->toString());
 
-    this->connect(
-        this->producer, &Node::nodeMoved,
-        this, &Edge::updatePoints
-    );
-    this->connect(
-        this->consumer, &Node::nodeMoved,
-        this, &Edge::updatePoints
-    );
-    this->connect(
-        this->producer, &Node::nodeResized,
-        this, &Edge::updatePoints
-    );
-    this->connect(
-        this->consumer, &Node::nodeResized,
-        this, &Edge::updatePoints
-    );
-
-    this->setAcceptedMouseButtons(Qt::NoButton);
-    this->setZValue(type>0 ? 3 : 2);
-
-    this->updatePoints();
-
-    this->scene->addItem(this);
+    this->scene->getEdgeLayer(this->type)->addEdge(this);
 }
 
 NE::Edge::~Edge() {
+    if(this->layer)
+        this->layer->removeEdge(this);
+}
+
+int NE::Edge::reset(
+    Node* producer,
+    int producerOutputPortIdx,
+    Node* consumer,
+    int consumerInputPortIdx,
+    int type
+){
+    this->release();
+    this->highlighted = false;
+    this->weight = 0;
+
+    this->producer = producer;
+    this->producerOutputPortIdx = producerOutputPortIdx;
+    this->consumer = consumer;
+    this->consumerInputPortIdx = consumerInputPortIdx;
+    this->type = type;
+    this->path = QPainterPath();
+
+    NE::log("  +Edge: "+ this->toString());
+
+    return this->scene->getEdgeLayer(this->type)->addEdge(this);
+}
+
+int NE::Edge::release(){
+    if(!this->layer)
+        return 0;
+
     NE::log("  -Edge: " + this->toString());
-    this->scene->removeItem(this);
+    return this->layer->removeEdge(this);
 }
 
 int NE::Edge::setType(int type){
+    if(this->type==type)
+        return this->type;
+
+    if(this->layer)
+        this->layer->removeEdge(this);
     this->type = type;
-    this->update(this->boundingRect());
+    this->path = QPainterPath();
+    this->scene->getEdgeLayer(this->type)->addEdge(this);
+
     return this->type;
 }
 
+int NE::Edge::setWeight(int weight){
+    weight = std::max(0, std::min(weight, NE::EdgeLayer::N_WEIGHTS-1));
+    if(this->weight==weight)
+        return 1;
+    this->weight = weight;
+    if(this->layer)
+        this->layer->updateWeight(this);
+    return 1;
+}
+
+int NE::Edge::setHighlighted(bool highlighted){
+    if(this->highlighted==highlighted)
+        return 1;
+    this->highlighted = highlighted;
+    if(this->layer)
+        this->layer->updateHighlight(this);
+    return 1;
+}
+
 std::string NE::Edge::toString(){
     std::stringstream ss;
 
@@ -88,73 +116,90 @@ std::string NE::Edge::toString(){
     return ss.str();
 }
 
-QRectF NE::Edge::boundingRect() const {
-    qreal x0 = std::min(this->oPoint.x(),std::min(this->cPoint.x(), this->iPoint.x()));
-    qreal y0 = std::min(this->oPoint.y(),std::min(this->cPoint.y(), this->iPoint.y()));
-    qreal x1 = std::max(this->oPoint.x(),std::max(this->cPoint.x(), this->iPoint.x()));
-    qreal y1 = std::max(this->oPoint.y(),std::max(this->cPoint.y(), this->iPoint.y()));
-
-    const qreal extra = 4.0;
-    return QRectF( x0,y0,x1-x0,y1-y0 )
-        .adjusted(-extra, -extra, extra, extra);
-}
-
 int NE::Edge::updatePoints(){
 
     auto nProducerOutputPorts = this->producer->getOutputPorts().size();
     auto b = this->producer->boundingRect();
 
-    this->prepareGeometryChange();
-
-    this->oPoint = QGraphicsItem::mapFromItem(this->producer->getOutputPorts()[this->producerOutputPortIdx]->getDisc(), 0, 0);
-    this->iPoint = QGraphicsItem::mapFromItem(this->consumer->getInputPorts()[this->consumerInputPortIdx]->getDisc(), 0, 0);
+    const auto oPoint = this->producer->getOutputPorts()[this->producerOutputPortIdx]->getDisc()->mapToScene(0, 0);
+    const auto iPoint = this->consumer->getInputPorts()[this->consumerInputPortIdx]->getDisc()->mapToScene(0, 0);
 
-    this->cPoint = this->type==0
-        ? this->oPoint
-        : this->mapFromItem(
-            this->producer,
-            b.bottomRight()) + QPointF((nProducerOutputPorts-this->producerOutputPortIdx)*15,
+    const auto cPoint = this->type==0
+        ? oPoint
+        : this->producer->mapToScene(b.bottomRight()) + QPointF(
+            (nProducerOutputPorts-this->producerOutputPortIdx)*15,
             0
         );
 
-    return 1;
+    if(
+        !this->path.isEmpty()
+        && oPoint==this->oPoint
+        && cPoint==this->cPoint
+        && iPoint==this->iPoint
+    )
+        return 0;
+
+    this->oPoint = oPoint;
+    this->cPoint = cPoint;
+    this->iPoint = iPoint;
+
+    return this->updateGeometry();
 }
 
-void NE::Edge::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *){
-    QLineF line(this->oPoint, this->iPoint);
+int NE::Edge::updateGeometry(){
+    this->path = QPainterPath();
+    this->path.moveTo(this->oPoint);
 
-    QPainterPath path;
-    path.moveTo(this->oPoint);
+    this->minimalPath = QPainterPath();
+    this->minimalPath.moveTo(this->oPoint);
 
     if(this->type==0){
-        path.lineTo(this->iPoint);
+        this->path.lineTo(this->iPoint);
+        this->minimalPath.lineTo(this->iPoint);
     } else {
-        path.quadTo(
+        this->path.quadTo(
             this->cPoint.x(), this->oPoint.y(),
             this->cPoint.x(), this->oPoint.y()+40
         );
-        path.lineTo(this->cPoint);
+        this->path.lineTo(this->cPoint);
         auto xt = 0.5*(this->cPoint.x()-this->iPoint.x());
         auto yt = 0.5*(this->iPoint.y()-this->cPoint.y());
-        path.cubicTo(
+        this->path.cubicTo(
             this->cPoint.x(), this->cPoint.y()+yt,
             this->iPoint.x()+xt, this->cPoint.y()+yt,
             this->iPoint.x(), this->iPoint.y()
         );
+
+        // straight segments are sufficient when zoomed out
+        this->minimalPath.lineTo(this->cPoint.x(), this->oPoint.y());
+        this->minimalPath.lineTo(this->cPoint);
+        this->minimalPath.lineTo(this->iPoint);
     }
 
-    painter->setPen(
-        QPen(
-            this->type==0
-                ? QApplication::palette().highlight().color()
-                : NE::CONSTS::COLOR_ORANGE,
-            NE::CONSTS::EDGE_WIDTH,
-            this->type==0
-                ? Qt::SolidLine
-                : Qt::DashDotLine,
-            Qt::RoundCap,
-            Qt::RoundJoin
-        )
-    );
-    painter->drawPath(path);
-}
\ No newline at end of file
+    // large enough for the widest stroke of weighted edges
+    const qreal extra = 0.5*NE::EdgeLayer::getWidth(NE::EdgeLayer::N_WEIGHTS-1) + 1;
+    this->bounds = this->path.controlPointRect()
+        .adjusted(-extra, -extra, extra, extra);
+
+    this->shapeValid = false;
+
+    return 1;
+}
+
+QPainterPath NE::Edge::shape() const {
+    // stroking is expensive, so the outline is only built on demand
+    if(!this->shapeValid){
+        QPainterPathStroker stroker;
+        stroker.setWidth(NE::CONSTS::EDGE_WIDTH);
+        stroker.setCapStyle(Qt::RoundCap);
+        stroker.setJoinStyle(Qt::RoundJoin);
+        this->shapePath = stroker.createStroke(this->path);
+        this->shapeValid = true;
+    }
+    return this->shapePath;
+}
+
+int NE::Edge::addToPath(QPainterPath& path, bool minimal) const {
+    path.addPath(this->getPath(minimal));
+    return 1;
+}
@@ -1,62 +1,140 @@
 #pragma once
 
 // QT includes
-#include <QGraphicsPathItem>
-#include <QGraphicsScene>
+#include <QPainterPath>
+#include <QPointF>
+#include <QRectF>
+
+// std includes
+#include <cstdint>
+#include <string>
 
 // forward declarations
 namespace NE {
     class Node;
+    class Scene;
+    class EdgeLayer;
 }
 
 namespace NE {
+    /// Stable reference to an edge in an EdgePool. The generation detects
+    /// references to edges that were released in the meantime.
+    struct EdgeHandle {
+        uint32_t index{0};
+        uint32_t generation{0};
+
+        bool operator==(const EdgeHandle& other) const {
+            return this->index==other.index && this->generation==other.generation;
+        }
+    };
+
     /// Every instance of this class corresponds to an edge between an output port
-    /// and an input port. This class internally detects if the positions of the
-    /// corresponding ports change and updates itself automatically.
-    class Edge : public QObject, public QGraphicsPathItem {
-        Q_OBJECT
+    /// and an input port. Edges are not graphics items themselves; they are
+    /// drawn in batches by the EdgeLayer of their type, which also detects if
+    /// the positions of the corresponding ports change and updates the edges.
+    class Edge {
+        friend class EdgeLayer;
+        friend class EdgePool;
 
         public:
             Edge(
-                QGraphicsScene* scene,
+                NE::Scene* scene,
                 NE::Node* producer,
                 int producerOutputPortIdx,
                 NE::Node* consumer,
                 int consumerInputPortIdx,
-                int type = 0,
-                QGraphicsItem *parent = nullptr
+                int type = 0
             );
             ~Edge();
 
+            /// Connects a released edge to new ports and adds it to the
+            /// layer of its type.
+            int reset(
+                NE::Node* producer,
+                int producerOutputPortIdx,
+                NE::Node* consumer,
+                int consumerInputPortIdx,
+                int type = 0
+            );
+
+            /// Removes the edge from its layer, so that it can be reused.
+            int release();
+
+            EdgeHandle getHandle(){return this->handle;};
+
+            /// Highlighted edges are drawn on top of all other edges of
+            /// their layer, e.g., to mark the critical path.
+            int setHighlighted(bool highlighted);
+            bool isHighlighted(){return this->highlighted;};
+
+            /// Sets the stroke width class of the edge (0: uniform, 1-4: from
+            /// small to large data volumes).
+            int setWeight(int weight);
+            int getWeight(){return this->weight;};
+
+            /// Delete copy constructor.
+            Edge(const Edge&) =delete;
+            /// Delete copy constructor.
+            Edge& operator=(const Edge&) =delete;
+
             // sets the state of the edge (0:normal edge, 1: view edge)
             int setType(int type);
             int getType(){return this->type;};
 
             NE::Node* getProducer(){return this->producer;};
             NE::Node* getConsumer(){return this->consumer;};
+            int getProducerOutputPortIdx(){return this->producerOutputPortIdx;};
+            int getConsumerInputPortIdx(){return this->consumerInputPortIdx;};
 
             /// Print edge information.
             std::string toString();
 
-        public slots:
+            /// Recomputes the end points of the edge from the port positions.
+            /// This is called by the edge layer whenever a connected node
+            /// moves or is resized. The cached geometry is only rebuilt if
+            /// a point actually moved, in which case 1 is returned.
             int updatePoints();
 
-        protected:
+            /// Bounding rect of the stroked edge in scene coordinates.
+            QRectF boundingRect() const {return this->bounds;};
 
-            QRectF boundingRect() const override;
-            void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override;
+            /// Outline of the stroked edge in scene coordinates for hit-testing.
+            QPainterPath shape() const;
+
+            /// Returns the cached path of the edge in scene coordinates. At
+            /// minimal level of detail curves are replaced by straight segments.
+            const QPainterPath& getPath(bool minimal) const {
+                return minimal ? this->minimalPath : this->path;
+            };
+
+            /// Appends the cached path of the edge to a path.
+            int addToPath(QPainterPath& path, bool minimal) const;
 
         private:
-            QGraphicsScene* scene;
+            NE::Scene* scene;
+            NE::EdgeLayer* layer{nullptr};
+            size_t layerIndex{0};
+            EdgeHandle handle;
+            bool highlighted{false};
+            int weight{0};
 
             int type{0};
             QPointF oPoint;
             QPointF cPoint;
             QPointF iPoint;
 
+            // cached geometry
+            QPainterPath path;
+            QPainterPath minimalPath;
+            QRectF bounds;
+            mutable QPainterPath shapePath;
+            mutable bool shapeValid{false};
+
+            int updateGeometry();
+
             NE::Node* producer;
             int producerOutputPortIdx;
             NE::Node* consumer;
             int consumerInputPortIdx;
     };
-}
\ No newline at end of file
+}
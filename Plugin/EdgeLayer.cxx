@@ -0,0 +1,295 @@
+#include <EdgeLayer.h>
+
+// node editor includes
+#include <Utils.h>
+#include <Node.h>
+#include <Edge.h>
+
+// qt includes
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+#include <QApplication>
+#include <QTimer>
+
+// std includes
+#include <algorithm>
+
+NE::EdgeLayer::EdgeLayer(int type, QGraphicsItem* parent) :
+    QObject(),
+    QGraphicsItem(parent),
+    type(type)
+{
+    this->setFlag(ItemUsesExtendedStyleOption);
+    this->setAcceptedMouseButtons(Qt::NoButton);
+    this->setZValue(type>0 ? 3 : 2);
+
+    // bounds only grow immediately and are shrunk at most once per interval,
+    // so that dragging a node does not visit all edges on every mouse move
+    this->boundsTimer = new QTimer(this);
+    this->boundsTimer->setSingleShot(true);
+    this->boundsTimer->setInterval(50);
+    QObject::connect(
+        this->boundsTimer, &QTimer::timeout,
+        this, &EdgeLayer::updateBounds
+    );
+
+    const QColor color = type==0
+        ? QApplication::palette().highlight().color()
+        : NE::CONSTS::COLOR_ORANGE;
+
+    for(int weight=0; weight<N_WEIGHTS; weight++){
+        this->pens[0][weight] = QPen(
+            color,
+            NE::EdgeLayer::getWidth(weight),
+            type==0
+                ? Qt::SolidLine
+                : Qt::DashDotLine,
+            Qt::RoundCap,
+            Qt::RoundJoin
+        );
+        this->pens[1][weight] = QPen(
+            color,
+            NE::EdgeLayer::getWidth(weight),
+            Qt::SolidLine,
+            Qt::RoundCap,
+            Qt::RoundJoin
+        );
+    }
+    this->highlightPen = QPen(
+        NE::CONSTS::COLOR_RED,
+        NE::CONSTS::EDGE_WIDTH,
+        Qt::SolidLine,
+        Qt::RoundCap,
+        Qt::RoundJoin
+    );
+}
+
+qreal NE::EdgeLayer::getWidth(int weight){
+    // uniform, then thin to thick with growing data volume
+    const qreal factors[N_WEIGHTS] = {1.0, 0.4, 1.0, 2.0, 3.0};
+    return factors[std::max(0, std::min(weight, N_WEIGHTS-1))]*NE::CONSTS::EDGE_WIDTH;
+}
+
+NE::EdgeLayer::~EdgeLayer(){
+    for(auto edge : this->edges)
+        edge->layer = nullptr;
+}
+
+int NE::EdgeLayer::addEdge(NE::Edge* edge){
+    edge->layer = this;
+    edge->layerIndex = this->edges.size();
+    this->edges.push_back(edge);
+
+    // listen to each node only once
+    for(auto node : {edge->getProducer(), edge->getConsumer()}){
+        auto& nodeEdges = this->nodeEdges[node];
+        if(nodeEdges.empty()){
+            QObject::connect(
+                node, &NE::Node::nodeMoved,
+                this, [=](){ this->updateNode(node); }
+            );
+            QObject::connect(
+                node, &NE::Node::nodeResized,
+                this, [=](){ this->updateNode(node); }
+            );
+        }
+        nodeEdges.push_back(edge);
+    }
+
+    edge->updatePoints();
+    if(edge->isHighlighted())
+        this->highlightedEdges.push_back(edge);
+
+    const auto rect = edge->boundingRect();
+    this->growBounds(rect);
+    this->dirty[0] = this->dirty[1] = true;
+    this->update(rect);
+
+    return 1;
+}
+
+int NE::EdgeLayer::removeEdge(NE::Edge* edge){
+    if(edge->layer!=this)
+        return 0;
+
+    // swap with the last edge to keep the array compact
+    auto last = this->edges.back();
+    this->edges[edge->layerIndex] = last;
+    last->layerIndex = edge->layerIndex;
+    this->edges.pop_back();
+    edge->layer = nullptr;
+
+    if(edge->isHighlighted())
+        this->highlightedEdges.erase(
+            std::remove(this->highlightedEdges.begin(), this->highlightedEdges.end(), edge),
+            this->highlightedEdges.end()
+        );
+
+    for(auto node : {edge->getProducer(), edge->getConsumer()}){
+        auto it = this->nodeEdges.find(node);
+        if(it==this->nodeEdges.end())
+            continue;
+
+        auto& nodeEdges = it->second;
+        nodeEdges.erase(
+            std::remove(nodeEdges.begin(), nodeEdges.end(), edge),
+            nodeEdges.end()
+        );
+        if(nodeEdges.empty()){
+            QObject::disconnect(node, nullptr, this, nullptr);
+            this->nodeEdges.erase(it);
+        }
+    }
+
+    this->dirty[0] = this->dirty[1] = true;
+    this->update(edge->boundingRect());
+    this->requestBoundsUpdate();
+
+    return 1;
+}
+
+int NE::EdgeLayer::updateNode(NE::Node* node){
+    auto it = this->nodeEdges.find(node);
+    if(it==this->nodeEdges.end())
+        return 0;
+
+    // repaint the old and the new region of every edge that moved
+    QRectF rect;
+    for(auto edge : it->second){
+        const auto oldRect = edge->boundingRect();
+        if(edge->updatePoints()){
+            rect |= oldRect;
+            rect |= edge->boundingRect();
+        }
+    }
+    if(rect.isNull())
+        return 1;
+
+    // the old extent may be left, which is only detected by the next update
+    this->growBounds(rect);
+    this->requestBoundsUpdate();
+    this->dirty[0] = this->dirty[1] = true;
+    this->update(rect);
+
+    return 1;
+}
+
+int NE::EdgeLayer::updateHighlight(NE::Edge* edge){
+    if(edge->layer!=this)
+        return 0;
+
+    if(edge->isHighlighted())
+        this->highlightedEdges.push_back(edge);
+    else
+        this->highlightedEdges.erase(
+            std::remove(this->highlightedEdges.begin(), this->highlightedEdges.end(), edge),
+            this->highlightedEdges.end()
+        );
+
+    this->update(edge->boundingRect());
+    return 1;
+}
+
+int NE::EdgeLayer::updateWeight(NE::Edge* edge){
+    if(edge->layer!=this)
+        return 0;
+
+    this->dirty[0] = this->dirty[1] = true;
+    this->update(edge->boundingRect());
+    return 1;
+}
+
+int NE::EdgeLayer::growBounds(const QRectF& rect){
+    if(this->bounds.contains(rect))
+        return 0;
+
+    this->prepareGeometryChange();
+    this->bounds |= rect;
+
+    return 1;
+}
+
+int NE::EdgeLayer::requestBoundsUpdate(){
+    if(this->boundsTimer->isActive())
+        return 0;
+    this->boundsTimer->start();
+    return 1;
+}
+
+int NE::EdgeLayer::updateBounds(){
+    // the layer also shrinks, so that it is fully exposed more often and
+    // paint can use the cached paths
+    QRectF rect;
+    for(auto edge : this->edges)
+        rect |= edge->boundingRect();
+    if(rect==this->bounds)
+        return 0;
+
+    this->prepareGeometryChange();
+    this->bounds = rect;
+
+    return 1;
+}
+
+NE::Edge* NE::EdgeLayer::getEdgeAt(const QPointF& pos){
+    for(auto it=this->edges.rbegin(); it!=this->edges.rend(); ++it)
+        if((*it)->boundingRect().contains(pos) && (*it)->shape().contains(pos))
+            return *it;
+    return nullptr;
+}
+
+QRectF NE::EdgeLayer::boundingRect() const {
+    return this->bounds;
+}
+
+QPainterPath NE::EdgeLayer::shape() const {
+    return QPainterPath();
+}
+
+void NE::EdgeLayer::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *){
+    const qreal lod = option->levelOfDetailFromTransform(painter->worldTransform());
+    const int style = lod<NE::CONSTS::LOD_MINIMAL_SCALE ? 1 : 0;
+    const bool minimal = style==1;
+
+    if(minimal)
+        painter->setRenderHint(QPainter::Antialiasing, false);
+
+    // stroke the cached paths if the whole layer is exposed
+    if(option->exposedRect.contains(this->bounds)){
+        if(this->dirty[style]){
+            for(auto& path : this->paths[style])
+                path = QPainterPath();
+            for(auto edge : this->edges)
+                edge->addToPath(this->paths[style][edge->getWeight()], minimal);
+            this->dirty[style] = false;
+        }
+        for(int weight=0; weight<N_WEIGHTS; weight++){
+            if(this->paths[style][weight].isEmpty())
+                continue;
+            painter->setPen(this->pens[style][weight]);
+            painter->drawPath(this->paths[style][weight]);
+        }
+    } else {
+        // otherwise only stroke the edges inside the exposed rect
+        QPainterPath paths[N_WEIGHTS];
+        for(auto edge : this->edges)
+            if(edge->boundingRect().intersects(option->exposedRect))
+                edge->addToPath(paths[edge->getWeight()], minimal);
+        for(int weight=0; weight<N_WEIGHTS; weight++){
+            if(paths[weight].isEmpty())
+                continue;
+            painter->setPen(this->pens[style][weight]);
+            painter->drawPath(paths[weight]);
+        }
+    }
+
+    if(this->highlightedEdges.empty())
+        return;
+
+    QPainterPath path;
+    for(auto edge : this->highlightedEdges)
+        if(edge->boundingRect().intersects(option->exposedRect))
+            edge->addToPath(path, minimal);
+    painter->setPen(this->highlightPen);
+    painter->drawPath(path);
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+// qt includes
+#include <QGraphicsItem>
+#include <QPainterPath>
+#include <QPen>
+
+// std includes
+#include <unordered_map>
+#include <vector>
+
+// forward declarations
+class QTimer;
+
+namespace NE {
+    class Node;
+    class Edge;
+}
+
+namespace NE {
+    /// This class draws all edges of one type (0: pipeline edge, 1: view edge)
+    /// as a single graphics item. The edges are stored in a compact array and
+    /// the layer listens once to every node that is connected by at least one
+    /// of its edges, so that only the affected edges are updated when a node
+    /// moves or is resized. The paths of all edges are merged into one cached
+    /// path per style and weight class that is only rebuilt after edges
+    /// changed.
+    class EdgeLayer : public QObject, public QGraphicsItem {
+        Q_OBJECT
+        Q_INTERFACES(QGraphicsItem)
+
+        public:
+            /// Number of stroke width classes of weighted edges, including
+            /// the uniform width.
+            static const int N_WEIGHTS = 5;
+
+            /// Returns the stroke width of a weight class.
+            static qreal getWidth(int weight);
+
+            EdgeLayer(int type, QGraphicsItem* parent=nullptr);
+            ~EdgeLayer();
+
+            int getType(){return this->type;};
+
+            const std::vector<NE::Edge*>& getEdges(){return this->edges;};
+
+            int addEdge(NE::Edge* edge);
+            int removeEdge(NE::Edge* edge);
+
+            /// Recomputes the points of all edges connected to a node and
+            /// repaints the region of the edges that actually moved.
+            int updateNode(NE::Node* node);
+
+            /// Adds or removes an edge from the highlighted edges that are
+            /// drawn on top of the layer.
+            int updateHighlight(NE::Edge* edge);
+
+            /// Repaints an edge whose weight class changed.
+            int updateWeight(NE::Edge* edge);
+
+            /// Returns the topmost edge whose stroke contains a scene
+            /// position, or nullptr.
+            NE::Edge* getEdgeAt(const QPointF& pos);
+
+            QRectF boundingRect() const override;
+
+            /// Edges do not take part in item queries, so the shape is empty.
+            QPainterPath shape() const override;
+
+        protected:
+            void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override;
+
+        private:
+            /// Grows the bounding rect of the layer to contain a rect.
+            int growBounds(const QRectF& rect);
+
+            /// Schedules updateBounds. Multiple requests within one interval
+            /// are coalesced.
+            int requestBoundsUpdate();
+
+            /// Recomputes the bounding rect of the layer from its edges after
+            /// edges were removed or moved.
+            int updateBounds();
+
+            int type;
+
+            std::vector<NE::Edge*> edges;
+            std::vector<NE::Edge*> highlightedEdges;
+            std::unordered_map<NE::Node*,std::vector<NE::Edge*>> nodeEdges;
+
+            QRectF bounds;
+            QTimer* boundsTimer;
+
+            // 0: full detail, 1: minimal detail; one pen and path per weight
+            QPen pens[2][N_WEIGHTS];
+            QPen highlightPen;
+            QPainterPath paths[2][N_WEIGHTS];
+            bool dirty[2]{true,true};
+    };
+}
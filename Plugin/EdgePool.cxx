@@ -0,0 +1,81 @@
+#include <EdgePool.h>
+
+// node editor includes
+#include <Edge.h>
+
+NE::EdgePool::EdgePool(NE::Scene* scene) :
+    scene(scene)
+{
+}
+
+NE::EdgePool::~EdgePool(){
+    for(auto& slot : this->slots)
+        delete slot.edge;
+}
+
+NE::EdgeHandle NE::EdgePool::create(
+    NE::Node* producer,
+    int producerOutputPortIdx,
+    NE::Node* consumer,
+    int consumerInputPortIdx,
+    int type
+){
+    uint32_t index;
+    if(this->freeSlots.empty()){
+        index = this->slots.size();
+        this->slots.emplace_back();
+    } else {
+        index = this->freeSlots.back();
+        this->freeSlots.pop_back();
+    }
+
+    auto& slot = this->slots[index];
+    slot.used = true;
+
+    NE::EdgeHandle handle;
+    handle.index = index;
+    handle.generation = slot.generation;
+
+    if(slot.edge){
+        slot.edge->handle = handle;
+        slot.edge->reset(producer, producerOutputPortIdx, consumer, consumerInputPortIdx, type);
+    } else {
+        slot.edge = new NE::Edge(
+            this->scene,
+            producer,
+            producerOutputPortIdx,
+            consumer,
+            consumerInputPortIdx,
+            type
+        );
+        slot.edge->handle = handle;
+    }
+
+    return handle;
+}
+
+int NE::EdgePool::release(NE::EdgeHandle handle){
+    auto edge = this->get(handle);
+    if(!edge)
+        return 0;
+
+    edge->release();
+
+    auto& slot = this->slots[handle.index];
+    slot.used = false;
+    slot.generation++;
+    this->freeSlots.push_back(handle.index);
+
+    return 1;
+}
+
+NE::Edge* NE::EdgePool::get(NE::EdgeHandle handle) const {
+    if(handle.index>=this->slots.size())
+        return nullptr;
+
+    const auto& slot = this->slots[handle.index];
+    if(!slot.used || slot.generation!=handle.generation)
+        return nullptr;
+
+    return slot.edge;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+// node editor includes
+#include <Edge.h>
+
+// std includes
+#include <cstdint>
+#include <vector>
+
+// forward declarations
+namespace NE {
+    class Node;
+    class Scene;
+}
+
+namespace NE {
+
+    /// This class owns all edges of a scene. Edges are referred to by stable
+    /// handles, and released edges are kept and reconnected by later
+    /// requests instead of being destroyed and allocated again.
+    class EdgePool {
+
+        public:
+            EdgePool(NE::Scene* scene);
+            ~EdgePool();
+
+            /// Delete copy constructor.
+            EdgePool(const EdgePool&) =delete;
+            /// Delete copy constructor.
+            EdgePool& operator=(const EdgePool&) =delete;
+
+            /// Connects a released edge or allocates a new one.
+            NE::EdgeHandle create(
+                NE::Node* producer,
+                int producerOutputPortIdx,
+                NE::Node* consumer,
+                int consumerInputPortIdx,
+                int type = 0
+            );
+
+            /// Removes an edge from the scene and keeps it for reuse.
+            /// Returns 0 if the handle refers to a released edge.
+            int release(NE::EdgeHandle handle);
+
+            /// Returns the edge of a handle or nullptr if it was released.
+            NE::Edge* get(NE::EdgeHandle handle) const;
+
+            /// Number of edges that are currently in use.
+            size_t size() const {return this->slots.size()-this->freeSlots.size();};
+
+        private:
+            struct Slot {
+                NE::Edge* edge{nullptr};
+                uint32_t generation{1};
+                bool used{false};
+            };
+
+            NE::Scene* scene;
+            std::vector<Slot> slots;
+            std::vector<uint32_t> freeSlots;
+    };
+}
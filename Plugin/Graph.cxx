@@ -0,0 +1,263 @@
+#include <Graph.h>
+
+// node editor includes
+#include <Node.h>
+#include <Edge.h>
+#include <Utils.h>
+
+// std includes
+#include <algorithm>
+#include <set>
+
+NE::Graph::Graph(NE::Scene* scene) :
+    edges(scene)
+{
+}
+
+NE::Graph::~Graph(){
+}
+
+NE::Graph::EdgeKey NE::Graph::getKey(NE::Edge* edge){
+    return EdgeKey(
+        NE::getID(edge->getProducer()->getProxy()),
+        edge->getProducerOutputPortIdx(),
+        NE::getID(edge->getConsumer()->getProxy()),
+        edge->getConsumerInputPortIdx(),
+        edge->getType()
+    );
+}
+
+int NE::Graph::addNode(int id, NE::Node* node, NodeKind kind, int nInputPorts, int nOutputPorts){
+    if(this->records.find(id)!=this->records.end())
+        return 0;
+
+    Record record;
+    record.node = node;
+    record.kind = kind;
+    record.inputs.resize(std::max(nInputPorts,0));
+    record.outputs.resize(std::max(nOutputPorts,0));
+    this->records.emplace(id, std::move(record));
+    this->nodes.emplace(id, node);
+
+    switch(kind){
+        case SOURCE: this->sources.insert(id); break;
+        case FILTER: this->filters.insert(id); break;
+        case VIEW:   this->views.insert(id);   break;
+    }
+
+    return 1;
+}
+
+int NE::Graph::removeNode(int id){
+    if(this->records.erase(id)<1)
+        return 0;
+
+    this->nodes.erase(id);
+    this->sources.erase(id);
+    this->filters.erase(id);
+    this->views.erase(id);
+
+    return 1;
+}
+
+NE::Graph::Record* NE::Graph::findRecord(int id){
+    auto it = this->records.find(id);
+    return it==this->records.end() ? nullptr : &it->second;
+}
+
+const NE::Graph::Record* NE::Graph::findRecord(int id) const {
+    auto it = this->records.find(id);
+    return it==this->records.end() ? nullptr : &it->second;
+}
+
+NE::Node* NE::Graph::getNode(int id) const {
+    auto it = this->nodes.find(id);
+    return it==this->nodes.end() ? nullptr : it->second;
+}
+
+NE::Graph::NodeKind NE::Graph::getKind(int id) const {
+    auto record = this->findRecord(id);
+    return record ? record->kind : SOURCE;
+}
+
+NE::Edge* NE::Graph::addEdge(
+    NE::Node* producerNode,
+    int producerOutputPortIdx,
+    NE::Node* consumerNode,
+    int consumerInputPortIdx,
+    int type
+){
+    auto producer = this->findRecord( NE::getID(producerNode->getProxy()) );
+    auto consumer = this->findRecord( NE::getID(consumerNode->getProxy()) );
+    if(!producer || !consumer)
+        return nullptr;
+
+    const size_t oPort = producerOutputPortIdx;
+    const size_t iPort = consumerInputPortIdx;
+    if(producer->outputs.size()<=oPort)
+        producer->outputs.resize(oPort+1);
+    if(consumer->inputs.size()<=iPort)
+        consumer->inputs.resize(iPort+1);
+
+    auto handle = this->edges.create(
+        producerNode,
+        producerOutputPortIdx,
+        consumerNode,
+        consumerInputPortIdx,
+        type
+    );
+    producer->outputs[oPort].push_back(handle);
+    consumer->inputs[iPort].push_back(handle);
+
+    return this->edges.get(handle);
+}
+
+int NE::Graph::removeEdge(NE::Edge* edge){
+    const auto handle = edge->getHandle();
+    auto erase = [=](std::vector<std::vector<NE::EdgeHandle>>& ports, size_t port){
+        if(port>=ports.size())
+            return;
+        auto& handles = ports[port];
+        handles.erase(std::remove(handles.begin(), handles.end(), handle), handles.end());
+    };
+
+    if(auto producer = this->findRecord( NE::getID(edge->getProducer()->getProxy()) ))
+        erase(producer->outputs, edge->getProducerOutputPortIdx());
+    if(auto consumer = this->findRecord( NE::getID(edge->getConsumer()->getProxy()) ))
+        erase(consumer->inputs, edge->getConsumerInputPortIdx());
+
+    return this->edges.release(handle);
+}
+
+const std::vector<std::vector<NE::EdgeHandle>>& NE::Graph::getInputs(int id) const {
+    auto record = this->findRecord(id);
+    return record ? record->inputs : this->noPorts;
+}
+
+const std::vector<std::vector<NE::EdgeHandle>>& NE::Graph::getOutputs(int id) const {
+    auto record = this->findRecord(id);
+    return record ? record->outputs : this->noPorts;
+}
+
+std::vector<NE::Edge*> NE::Graph::resolve(const std::vector<std::vector<NE::EdgeHandle>>& ports) const {
+    std::vector<NE::Edge*> edges;
+    for(const auto& port : ports)
+        for(const auto& handle : port)
+            if(auto edge = this->edges.get(handle))
+                edges.push_back(edge);
+    return edges;
+}
+
+std::vector<NE::Edge*> NE::Graph::getIncomingEdges(int id) const {
+    return this->resolve(this->getInputs(id));
+}
+
+std::vector<NE::Edge*> NE::Graph::getOutgoingEdges(int id) const {
+    return this->resolve(this->getOutputs(id));
+}
+
+std::vector<int> NE::Graph::getProducers(int id) const {
+    std::vector<int> producers;
+    for(auto edge : this->getIncomingEdges(id))
+        producers.push_back( NE::getID(edge->getProducer()->getProxy()) );
+    return producers;
+}
+
+std::vector<int> NE::Graph::getDownstream(const std::vector<int>& ids) const {
+    auto getConsumers = [=](int id){
+        std::vector<int> consumers;
+        for(auto edge : this->getOutgoingEdges(id))
+            if(edge->getType()==0)
+                consumers.push_back( NE::getID(edge->getConsumer()->getProxy()) );
+        return consumers;
+    };
+
+    // collect the closure
+    std::unordered_map<int,int> inDegrees;
+    std::vector<int> stack(ids.begin(), ids.end());
+    while(!stack.empty()){
+        const int id = stack.back();
+        stack.pop_back();
+        if(!this->findRecord(id) || !inDegrees.emplace(id,0).second)
+            continue;
+        for(auto consumerId : getConsumers(id))
+            stack.push_back(consumerId);
+    }
+
+    // order the closure by repeatedly taking nodes without pending producers
+    for(const auto& it : inDegrees)
+        for(auto consumerId : getConsumers(it.first))
+            inDegrees[consumerId]++;
+
+    std::set<int> ready;
+    for(const auto& it : inDegrees)
+        if(it.second==0)
+            ready.insert(it.first);
+
+    std::vector<int> order;
+    order.reserve(inDegrees.size());
+    while(!ready.empty()){
+        const int id = *ready.begin();
+        ready.erase(ready.begin());
+        order.push_back(id);
+        for(auto consumerId : getConsumers(id))
+            if(--inDegrees[consumerId]==0)
+                ready.insert(consumerId);
+    }
+
+    return order;
+}
+
+std::vector<int> NE::Graph::getCriticalPath(
+    const std::unordered_map<int,double>& weights,
+    double& length
+) const {
+    // views only have incoming edges, so they follow all other nodes
+    std::vector<int> ids(this->sources.begin(), this->sources.end());
+    ids.insert(ids.end(), this->filters.begin(), this->filters.end());
+    auto order = this->getDownstream(ids);
+    order.insert(order.end(), this->views.begin(), this->views.end());
+
+    auto getWeight = [&](int id){
+        auto it = weights.find(id);
+        return it==weights.end() ? 0.0 : it->second;
+    };
+
+    // longest distances from any source
+    std::unordered_map<int,double> distances;
+    std::unordered_map<int,int> predecessors;
+    int last = -1;
+    length = 0;
+    for(auto id : order){
+        double distance = 0;
+        int predecessor = -1;
+        for(auto producerId : this->getProducers(id)){
+            auto it = distances.find(producerId);
+            if(it!=distances.end() && (predecessor<0 || it->second>distance)){
+                distance = it->second;
+                predecessor = producerId;
+            }
+        }
+
+        distance += getWeight(id);
+        distances[id] = distance;
+        if(predecessor>=0)
+            predecessors[id] = predecessor;
+
+        // prefer later nodes on ties, so the path ends in a view if possible
+        if(distance>0 && distance>=length){
+            length = distance;
+            last = id;
+        }
+    }
+
+    std::vector<int> path;
+    while(last>=0){
+        path.push_back(last);
+        auto it = predecessors.find(last);
+        last = it==predecessors.end() ? -1 : it->second;
+    }
+    std::reverse(path.begin(), path.end());
+
+    return path;
+}
@@ -0,0 +1,138 @@
+#pragma once
+
+// node editor includes
+#include <EdgePool.h>
+
+// std includes
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// forward declarations
+namespace NE {
+    class Node;
+    class Edge;
+    class Scene;
+}
+
+namespace NE {
+
+    /// This class is the model of the pipeline shown in the node editor. It
+    /// stores every node together with its kind and the incoming and outgoing
+    /// edges of each of its ports, and keeps separate indexes of all sources,
+    /// filters and views. All nodes are keyed by the global identifier of
+    /// their proxy. The graph does not own its nodes, but it owns all edges
+    /// in a pool and refers to them through stable handles.
+    class Graph {
+
+        public:
+            enum NodeKind {
+                SOURCE = 0,
+                FILTER = 1,
+                VIEW = 2
+            };
+
+            /// Identifies an edge by (producer id, output port, consumer id,
+            /// input port, edge type).
+            using EdgeKey = std::tuple<int,int,int,int,int>;
+
+            static EdgeKey getKey(NE::Edge* edge);
+
+            Graph(NE::Scene* scene);
+            ~Graph();
+
+            /// Registers a node with the given number of ports.
+            int addNode(int id, NE::Node* node, NodeKind kind, int nInputPorts, int nOutputPorts);
+
+            /// Unregisters a node. All edges of the node have to be removed
+            /// beforehand. Returns 0 if the node does not exist.
+            int removeNode(int id);
+
+            /// Returns the node with the given id or nullptr.
+            NE::Node* getNode(int id) const;
+            NodeKind getKind(int id) const;
+
+            const std::unordered_map<int,NE::Node*>& getNodes() const {
+                return this->nodes;
+            }
+            const std::unordered_set<int>& getSources() const {
+                return this->sources;
+            }
+            const std::unordered_set<int>& getFilters() const {
+                return this->filters;
+            }
+            const std::unordered_set<int>& getViews() const {
+                return this->views;
+            }
+
+            /// Creates an edge and registers it at the output port of its
+            /// producer and the input port of its consumer. Returns nullptr
+            /// if one of the nodes is not registered.
+            NE::Edge* addEdge(
+                NE::Node* producer,
+                int producerOutputPortIdx,
+                NE::Node* consumer,
+                int consumerInputPortIdx,
+                int type = 0
+            );
+
+            /// Unregisters an edge from its producer and consumer and
+            /// returns it to the pool.
+            int removeEdge(NE::Edge* edge);
+
+            /// Returns the edge of a handle or nullptr if it was removed.
+            NE::Edge* getEdge(NE::EdgeHandle handle) const {
+                return this->edges.get(handle);
+            }
+
+            /// Returns the handles of the incoming edges of a node per input port.
+            const std::vector<std::vector<NE::EdgeHandle>>& getInputs(int id) const;
+
+            /// Returns the handles of the outgoing edges of a node per output port.
+            const std::vector<std::vector<NE::EdgeHandle>>& getOutputs(int id) const;
+
+            /// Returns all incoming/outgoing edges of a node.
+            std::vector<NE::Edge*> getIncomingEdges(int id) const;
+            std::vector<NE::Edge*> getOutgoingEdges(int id) const;
+
+            /// Returns the ids of all producers of a node in port order.
+            std::vector<int> getProducers(int id) const;
+
+            /// Returns the given nodes and all nodes downstream of them
+            /// along pipeline edges in topological order.
+            std::vector<int> getDownstream(const std::vector<int>& ids) const;
+
+            /// Returns the chain of nodes from a source to a sink with the
+            /// largest sum of node weights, e.g., execution times, and
+            /// stores this sum in length. Nodes without a weight count zero.
+            std::vector<int> getCriticalPath(
+                const std::unordered_map<int,double>& weights,
+                double& length
+            ) const;
+
+        private:
+            struct Record {
+                NE::Node* node;
+                NodeKind kind;
+                std::vector<std::vector<NE::EdgeHandle>> inputs;
+                std::vector<std::vector<NE::EdgeHandle>> outputs;
+            };
+
+            std::vector<NE::Edge*> resolve(const std::vector<std::vector<NE::EdgeHandle>>& ports) const;
+
+            Record* findRecord(int id);
+            const Record* findRecord(int id) const;
+
+            NE::EdgePool edges;
+
+            std::unordered_map<int,Record> records;
+            std::unordered_map<int,NE::Node*> nodes;
+
+            std::unordered_set<int> sources;
+            std::unordered_set<int> filters;
+            std::unordered_set<int> views;
+
+            const std::vector<std::vector<NE::EdgeHandle>> noPorts;
+    };
+}
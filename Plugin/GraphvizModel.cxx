@@ -0,0 +1,234 @@
+#include <GraphvizModel.h>
+
+// node editor includes
+#include <Utils.h>
+
+// std includes
+#include <algorithm>
+#include <cassert>
+#include <string>
+#include <utility>
+
+namespace {
+    // graphviz uses global state and must not run concurrently
+    std::mutex graphvizMutex;
+
+    // one pixel corresponds to one point, i.e., 1/72 inch
+    const double DPI = 72.0;
+
+    char* toChars(const char* string){
+        return const_cast<char*>(string);
+    }
+}
+
+NE::GraphvizModel::GraphvizModel(){
+    std::lock_guard<std::mutex> lock(graphvizMutex);
+
+    this->gvc = gvContext();
+    this->graph = agopen(toChars("g"), Agdirected, nullptr);
+
+    agattr(this->graph, AGRAPH, toChars("rankdir"), toChars("LR"));
+    agattr(this->graph, AGRAPH, toChars("pad"), toChars("0"));
+    agattr(
+        this->graph, AGRAPH, toChars("ranksep"),
+        toChars(std::to_string(NE::CONSTS::LAYOUT_RANK_SEPARATION/DPI).data())
+    );
+    agattr(
+        this->graph, AGRAPH, toChars("nodesep"),
+        toChars(std::to_string(NE::CONSTS::LAYOUT_NODE_SEPARATION/DPI).data())
+    );
+
+    agattr(this->graph, AGNODE, toChars("label"), toChars(""));
+    agattr(this->graph, AGNODE, toChars("shape"), toChars("box"));
+    agattr(this->graph, AGNODE, toChars("fixedsize"), toChars("true"));
+    this->widthSymbol = agattr(this->graph, AGNODE, toChars("width"), toChars("1"));
+    this->heightSymbol = agattr(this->graph, AGNODE, toChars("height"), toChars("1"));
+}
+
+NE::GraphvizModel::~GraphvizModel(){
+    std::lock_guard<std::mutex> layoutLock(this->layoutMutex);
+    std::lock_guard<std::mutex> lock(graphvizMutex);
+
+    if(this->hasLayout)
+        gvFreeLayout(this->gvc, this->graph);
+    agclose(this->graph);
+    gvFreeContext(this->gvc);
+}
+
+int NE::GraphvizModel::addNode(int id, double width, double height){
+    return this->record({ Operation::ADD, id, width, height, {} });
+}
+
+int NE::GraphvizModel::removeNode(int id){
+    return this->record({ Operation::REMOVE, id, 0, 0, {} });
+}
+
+int NE::GraphvizModel::resizeNode(int id, double width, double height){
+    return this->record({ Operation::RESIZE, id, width, height, {} });
+}
+
+int NE::GraphvizModel::setIncomingEdges(int id, const std::vector<int>& producers){
+    return this->record({ Operation::EDGES, id, 0, 0, producers });
+}
+
+int NE::GraphvizModel::record(const Operation& operation){
+    std::lock_guard<std::mutex> lock(this->operationsMutex);
+    this->operations.push_back(operation);
+    this->revision++;
+    return 1;
+}
+
+unsigned int NE::GraphvizModel::getRevision(){
+    std::lock_guard<std::mutex> lock(this->operationsMutex);
+    return this->revision;
+}
+
+int NE::GraphvizModel::setSize(Agnode_t* node, double width, double height){
+    agxset(node, this->widthSymbol, toChars(std::to_string(width/DPI).data()));
+    agxset(node, this->heightSymbol, toChars(std::to_string(height/DPI).data()));
+    return 1;
+}
+
+int NE::GraphvizModel::applyOperations(unsigned int revision){
+    // changes recorded after the snapshot stay queued for the next layout
+    std::vector<Operation> operations;
+    {
+        std::lock_guard<std::mutex> lock(this->operationsMutex);
+        const auto end = this->operations.begin() + (revision-this->appliedRevision);
+        operations.assign(
+            std::make_move_iterator(this->operations.begin()),
+            std::make_move_iterator(end)
+        );
+        this->operations.erase(this->operations.begin(), end);
+    }
+    this->appliedRevision = revision;
+
+    for(const auto& operation : operations){
+        auto nodeIt = this->gvNodes.find(operation.id);
+
+        switch(operation.type){
+            case Operation::ADD: {
+                if(nodeIt!=this->gvNodes.end())
+                    break;
+                auto node = agnode(this->graph, toChars(std::to_string(operation.id).data()), 1);
+                this->setSize(node, operation.width, operation.height);
+                this->gvNodes.insert({ operation.id, node });
+                this->sizes[operation.id] = { operation.width, operation.height };
+                break;
+            }
+            case Operation::REMOVE: {
+                // deleting a node also deletes all of its edges
+                if(nodeIt==this->gvNodes.end())
+                    break;
+                agdelnode(this->graph, nodeIt->second);
+                this->gvNodes.erase(nodeIt);
+                this->sizes.erase(operation.id);
+                break;
+            }
+            case Operation::RESIZE: {
+                if(nodeIt==this->gvNodes.end())
+                    break;
+                this->setSize(nodeIt->second, operation.width, operation.height);
+                this->sizes[operation.id] = { operation.width, operation.height };
+                break;
+            }
+            case Operation::EDGES: {
+                if(nodeIt==this->gvNodes.end())
+                    break;
+                auto consumer = nodeIt->second;
+                for(auto edge = agfstin(this->graph, consumer); edge;){
+                    auto next = agnxtin(this->graph, edge);
+                    agdeledge(this->graph, edge);
+                    edge = next;
+                }
+                for(auto producerId : operation.producers){
+                    auto producerIt = this->gvNodes.find(producerId);
+                    if(producerIt!=this->gvNodes.end())
+                        agedge(this->graph, producerIt->second, consumer, nullptr, 1);
+                }
+                break;
+            }
+        }
+    }
+
+    return 1;
+}
+
+bool NE::GraphvizModel::matches(const NE::LayoutGraph& graph){
+    if(this->gvNodes.size()!=graph.nodes.size())
+        return false;
+    for(const auto& node : graph.nodes){
+        auto sizeIt = this->sizes.find(node.id);
+        if(
+            !this->gvNodes.count(node.id)
+            || sizeIt==this->sizes.end()
+            || sizeIt->second!=std::make_pair(node.width, node.height)
+        )
+            return false;
+    }
+
+    std::unordered_map<Agnode_t*,int> ids;
+    for(const auto& it : this->gvNodes)
+        ids[it.second] = it.first;
+
+    std::vector<std::pair<int,int>> edges;
+    for(const auto& it : this->gvNodes)
+        for(auto edge = agfstout(this->graph, it.second); edge; edge = agnxtout(this->graph, edge))
+            edges.emplace_back(it.first, ids[aghead(edge)]);
+
+    std::vector<std::pair<int,int>> expectedEdges;
+    for(const auto& edge : graph.edges)
+        expectedEdges.emplace_back(graph.nodes[edge.producer].id, graph.nodes[edge.consumer].id);
+
+    std::sort(edges.begin(), edges.end());
+    std::sort(expectedEdges.begin(), expectedEdges.end());
+    return edges==expectedEdges;
+}
+
+int NE::GraphvizModel::computeLayout(
+    const NE::LayoutGraph& graph,
+    NE::LayoutResult& result,
+    const std::atomic<bool>* cancelled
+){
+    std::lock_guard<std::mutex> layoutLock(this->layoutMutex);
+
+    // a newer snapshot was laid out in the meantime, so the changes that
+    // belong to this one can no longer be separated
+    if((cancelled && *cancelled) || graph.revision<this->appliedRevision)
+        return 0;
+
+    std::lock_guard<std::mutex> lock(graphvizMutex);
+
+    // the previous layout has to be released before the graph is modified
+    if(this->hasLayout)
+        gvFreeLayout(this->gvc, this->graph);
+    this->hasLayout = false;
+
+    this->applyOperations(graph.revision);
+    assert(this->matches(graph));
+
+    if(gvLayout(this->gvc, this->graph, "dot")!=0)
+        return 0;
+    this->hasLayout = true;
+
+    // graphviz returns node centers with the y-axis pointing up
+    result.assign(graph.nodes.size(), {0.0,0.0});
+    double minY = 0;
+    bool first = true;
+    for(size_t i=0; i<graph.nodes.size(); i++){
+        auto nodeIt = this->gvNodes.find(graph.nodes[i].id);
+        if(nodeIt==this->gvNodes.end())
+            continue;
+
+        const auto& size = this->sizes[graph.nodes[i].id];
+        const auto& coord = ND_coord(nodeIt->second);
+        result[i].first = coord.x - 0.5*size.first;
+        result[i].second = -coord.y - 0.5*size.second;
+        minY = first ? result[i].second : std::min(minY, result[i].second);
+        first = false;
+    }
+    for(auto& p : result)
+        p.second -= minY;
+
+    return 1;
+}
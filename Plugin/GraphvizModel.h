@@ -0,0 +1,90 @@
+#pragma once
+
+// node editor includes
+#include <Layout.h>
+
+// std includes
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// graphviz includes
+#include <graphviz/cgraph.h>
+#include <graphviz/gvc.h>
+
+namespace NE {
+
+    /// This class keeps a GraphViz graph of all source and filter nodes alive
+    /// for the whole session and reuses a single GVC context. Changes of the
+    /// pipeline are recorded on the GUI thread and applied to the graph right
+    /// before the next layout, which can then run on any thread without
+    /// rebuilding the graph. Every recorded change increments the revision,
+    /// and a layout only applies the changes up to the revision of its
+    /// snapshot, so that the graph always matches the snapshot.
+    class GraphvizModel {
+
+        public:
+            GraphvizModel();
+            ~GraphvizModel();
+
+            /// Delete copy constructor.
+            GraphvizModel(const GraphvizModel&) =delete;
+            /// Delete copy constructor.
+            GraphvizModel& operator=(const GraphvizModel&) =delete;
+
+            int addNode(int id, double width, double height);
+            int removeNode(int id);
+            int resizeNode(int id, double width, double height);
+
+            /// Replaces all incoming edges of a node.
+            int setIncomingEdges(int id, const std::vector<int>& producers);
+
+            /// Returns the number of recorded changes.
+            unsigned int getRevision();
+
+            /// Computes the dot layout and returns the positions of all nodes
+            /// of the given snapshot. Returns 0 if the computation was aborted
+            /// via *cancelled* or if a newer snapshot was already laid out.
+            int computeLayout(
+                const NE::LayoutGraph& graph,
+                NE::LayoutResult& result,
+                const std::atomic<bool>* cancelled = nullptr
+            );
+
+        private:
+            struct Operation {
+                enum Type { ADD, REMOVE, RESIZE, EDGES };
+                Type type;
+                int id;
+                double width;
+                double height;
+                std::vector<int> producers;
+            };
+
+            int record(const Operation& operation);
+
+            /// Applies the recorded changes up to a revision.
+            int applyOperations(unsigned int revision);
+            int setSize(Agnode_t* node, double width, double height);
+
+            /// Checks that the graph contains exactly the nodes, sizes and
+            /// edges of a snapshot. Only used in debug builds.
+            bool matches(const NE::LayoutGraph& graph);
+
+            std::mutex operationsMutex;
+            std::vector<Operation> operations;
+            unsigned int revision{0};
+            unsigned int appliedRevision{0};
+
+            std::mutex layoutMutex;
+            GVC_t* gvc;
+            Agraph_t* graph;
+            Agsym_t* widthSymbol;
+            Agsym_t* heightSymbol;
+            bool hasLayout{false};
+
+            std::unordered_map<int,Agnode_t*> gvNodes;
+            std::unordered_map<int,std::pair<double,double>> sizes;
+    };
+}
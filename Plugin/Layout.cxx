@@ -0,0 +1,682 @@
+#include <Layout.h>
+
+// node editor includes
+#include <Utils.h>
+
+// qt includes
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThreadPool>
+
+// std includes
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <numeric>
+
+namespace {
+
+    /// Runs a functor on a pool thread and signals its completion.
+    class LayoutWorker : public QRunnable {
+        public:
+            LayoutWorker(std::function<void()> functor, QSemaphore& done) :
+                functor(functor), done(done){}
+            void run() override {
+                this->functor();
+                this->done.release();
+            }
+        private:
+            std::function<void()> functor;
+            QSemaphore& done;
+    };
+
+    /// Internal state of the layered layout that also contains dummy nodes.
+    struct Layering {
+        std::vector<double> width;
+        std::vector<double> height;
+        std::vector<bool> isDummy;
+
+        // neighbors in the previous and next layer
+        std::vector<std::vector<int>> up;
+        std::vector<std::vector<int>> down;
+
+        std::vector<std::vector<int>> layers;
+        std::vector<int> position; // position of each vertex in its layer
+
+        int addVertex(double width, double height, bool isDummy){
+            this->width.push_back(width);
+            this->height.push_back(height);
+            this->isDummy.push_back(isDummy);
+            this->up.emplace_back();
+            this->down.emplace_back();
+            this->position.push_back(0);
+            return this->width.size()-1;
+        }
+
+        int updatePositions(int layer){
+            const auto& vertices = this->layers[layer];
+            for(size_t i=0; i<vertices.size(); i++)
+                this->position[vertices[i]] = i;
+            return 1;
+        }
+    };
+
+    /// Counts the edge crossings between a layer and its successor by counting
+    /// inversions with a Fenwick tree.
+    long countCrossings(const Layering& layering, int layer){
+        std::vector<std::pair<int,int>> edges;
+        for(auto v : layering.layers[layer])
+            for(auto w : layering.down[v])
+                edges.emplace_back(layering.position[v], layering.position[w]);
+        std::sort(edges.begin(), edges.end());
+
+        const int n = layering.layers[layer+1].size();
+        std::vector<int> tree(n+1, 0);
+        long crossings = 0;
+        long inserted = 0;
+        for(const auto& edge : edges){
+            // the prefix sum counts the inserted edges whose lower endpoint
+            // is at or before the one of this edge; the others start before
+            // this edge in the upper layer and end after it, i.e., they cross
+            int count = 0;
+            for(int i=edge.second+1; i>0; i-=i&(-i))
+                count += tree[i];
+            crossings += inserted - count;
+            for(int i=edge.second+1; i<=n; i+=i&(-i))
+                tree[i]++;
+            inserted++;
+        }
+        return crossings;
+    }
+
+    long countCrossings(const Layering& layering){
+        long crossings = 0;
+        for(size_t r=0; r+1<layering.layers.size(); r++)
+            crossings += countCrossings(layering, r);
+        return crossings;
+    }
+
+    /// Reorders a layer by the barycenters of the neighbors in the adjacent layer.
+    int sortByBarycenter(Layering& layering, int layer, bool useUp){
+        auto& vertices = layering.layers[layer];
+        std::vector<std::pair<double,int>> keys;
+        keys.reserve(vertices.size());
+        for(auto v : vertices){
+            const auto& neighbors = useUp ? layering.up[v] : layering.down[v];
+            double barycenter = layering.position[v];
+            if(neighbors.size()>0){
+                barycenter = 0;
+                for(auto w : neighbors)
+                    barycenter += layering.position[w];
+                barycenter /= neighbors.size();
+            }
+            keys.emplace_back(barycenter, v);
+        }
+
+        std::stable_sort(
+            keys.begin(),
+            keys.end(),
+            [](const std::pair<double,int>& a, const std::pair<double,int>& b){
+                return a.first<b.first;
+            }
+        );
+
+        for(size_t i=0; i<keys.size(); i++)
+            vertices[i] = keys[i].second;
+
+        return layering.updatePositions(layer);
+    }
+
+    /// Places the vertices of a layer as close as possible to the target
+    /// centers while keeping their order and the minimum separation. This is
+    /// an isotonic regression that is solved with the pool adjacent violators
+    /// algorithm.
+    int placeLayer(
+        const Layering& layering,
+        int layer,
+        const std::vector<double>& targets,
+        std::vector<double>& centers,
+        double nodeSeparation
+    ){
+        const auto& vertices = layering.layers[layer];
+        const int n = vertices.size();
+        if(n<1)
+            return 1;
+
+        // offsets that turn the separation constraints into order constraints
+        std::vector<double> offsets(n, 0.0);
+        for(int i=1; i<n; i++){
+            const int a = vertices[i-1];
+            const int b = vertices[i];
+            const double separation = layering.isDummy[a] || layering.isDummy[b]
+                ? 0.5*nodeSeparation
+                : nodeSeparation;
+            offsets[i] = offsets[i-1]
+                + 0.5*(layering.height[a] + layering.height[b])
+                + separation;
+        }
+
+        // blocks of merged vertices with their mean value and size
+        std::vector<double> means;
+        std::vector<int> sizes;
+        for(int i=0; i<n; i++){
+            means.push_back(targets[i]-offsets[i]);
+            sizes.push_back(1);
+            while(means.size()>1 && means[means.size()-2]>means.back()){
+                const int s0 = sizes[sizes.size()-2];
+                const int s1 = sizes.back();
+                const double mean = (means[means.size()-2]*s0 + means.back()*s1)/(s0+s1);
+                means.pop_back();
+                sizes.pop_back();
+                means.back() = mean;
+                sizes.back() = s0+s1;
+            }
+        }
+
+        int i = 0;
+        for(size_t b=0; b<means.size(); b++)
+            for(int j=0; j<sizes[b]; j++, i++)
+                centers[vertices[i]] = means[b]+offsets[i];
+
+        return 1;
+    }
+}
+
+int NE::computeLayeredLayout(
+    const NE::LayoutGraph& graph,
+    NE::LayoutResult& result,
+    const std::atomic<bool>* cancelled
+){
+    auto isCancelled = [=](){
+        return cancelled && cancelled->load();
+    };
+
+    const int nNodes = graph.nodes.size();
+    result.assign(nNodes, {0.0,0.0});
+    if(nNodes<1)
+        return 1;
+
+    const double rankSeparation = NE::CONSTS::LAYOUT_RANK_SEPARATION;
+    const double nodeSeparation = NE::CONSTS::LAYOUT_NODE_SEPARATION;
+
+    // collect unique edges without self loops
+    std::vector<std::vector<int>> successors(nNodes);
+    std::vector<int> inDegree(nNodes, 0);
+    for(const auto& edge : graph.edges)
+        if(edge.producer!=edge.consumer)
+            successors[edge.producer].push_back(edge.consumer);
+    for(auto& s : successors){
+        std::sort(s.begin(), s.end());
+        s.erase(std::unique(s.begin(), s.end()), s.end());
+        for(auto v : s)
+            inDegree[v]++;
+    }
+
+    // topological order; cycles are broken at the vertex with the smallest in-degree
+    std::vector<int> order;
+    {
+        std::vector<int> degree = inDegree;
+        std::vector<bool> visited(nNodes, false);
+        std::vector<int> queue;
+        for(int v=0; v<nNodes; v++)
+            if(degree[v]==0)
+                queue.push_back(v);
+
+        while((int)order.size()<nNodes){
+            if(queue.empty()){
+                int best = -1;
+                for(int v=0; v<nNodes; v++)
+                    if(!visited[v] && (best<0 || degree[v]<degree[best]))
+                        best = v;
+                queue.push_back(best);
+            }
+
+            // process vertices in index order for deterministic results
+            std::vector<int> next;
+            for(auto v : queue){
+                if(visited[v])
+                    continue;
+                visited[v] = true;
+                order.push_back(v);
+                for(auto w : successors[v])
+                    if(!visited[w] && --degree[w]==0)
+                        next.push_back(w);
+            }
+            std::sort(next.begin(), next.end());
+            queue = next;
+        }
+    }
+
+    std::vector<int> topoIndex(nNodes);
+    for(int i=0; i<nNodes; i++)
+        topoIndex[order[i]] = i;
+
+    // acyclic edges; edges against the topological order are reversed
+    std::vector<std::vector<int>> dagSuccessors(nNodes);
+    std::vector<std::vector<int>> dagPredecessors(nNodes);
+    for(int v=0; v<nNodes; v++)
+        for(auto w : successors[v]){
+            const int a = topoIndex[v]<topoIndex[w] ? v : w;
+            const int b = topoIndex[v]<topoIndex[w] ? w : v;
+            dagSuccessors[a].push_back(b);
+            dagPredecessors[b].push_back(a);
+        }
+    for(int v=0; v<nNodes; v++){
+        auto& s = dagSuccessors[v];
+        std::sort(s.begin(), s.end());
+        s.erase(std::unique(s.begin(), s.end()), s.end());
+        auto& p = dagPredecessors[v];
+        std::sort(p.begin(), p.end());
+        p.erase(std::unique(p.begin(), p.end()), p.end());
+    }
+
+    // longest path ranking
+    std::vector<int> rank(nNodes, 0);
+    for(auto v : order)
+        for(auto u : dagPredecessors[v])
+            rank[v] = std::max(rank[v], rank[u]+1);
+
+    // move sources next to their closest consumer
+    for(int i=nNodes-1; i>=0; i--){
+        const int v = order[i];
+        if(dagPredecessors[v].size()>0 || dagSuccessors[v].size()<1)
+            continue;
+        int minRank = std::numeric_limits<int>::max();
+        for(auto w : dagSuccessors[v])
+            minRank = std::min(minRank, rank[w]);
+        rank[v] = minRank-1;
+    }
+
+    const int nRanks = *std::max_element(rank.begin(), rank.end())+1;
+
+    if(isCancelled())
+        return 0;
+
+    // build layers and split long edges with dummy vertices
+    Layering layering;
+    layering.layers.resize(nRanks);
+    for(int v=0; v<nNodes; v++)
+        layering.addVertex(graph.nodes[v].width, graph.nodes[v].height, false);
+    for(auto v : order)
+        layering.layers[rank[v]].push_back(v);
+
+    for(auto v : order)
+        for(auto w : dagSuccessors[v]){
+            int last = v;
+            for(int r=rank[v]+1; r<rank[w]; r++){
+                const int dummy = layering.addVertex(0.0, 0.0, true);
+                layering.layers[r].push_back(dummy);
+                layering.down[last].push_back(dummy);
+                layering.up[dummy].push_back(last);
+                last = dummy;
+            }
+            layering.down[last].push_back(w);
+            layering.up[w].push_back(last);
+        }
+
+    for(int r=0; r<nRanks; r++)
+        layering.updatePositions(r);
+
+    // crossing reduction
+    {
+        auto bestLayers = layering.layers;
+        long bestCrossings = countCrossings(layering);
+
+        const int nIterations = 12;
+        for(int i=0; i<nIterations && bestCrossings>0; i++){
+            if(isCancelled())
+                return 0;
+
+            if(i%2==0)
+                for(int r=1; r<nRanks; r++)
+                    sortByBarycenter(layering, r, true);
+            else
+                for(int r=nRanks-2; r>=0; r--)
+                    sortByBarycenter(layering, r, false);
+
+            const long crossings = countCrossings(layering);
+            if(crossings<bestCrossings){
+                bestCrossings = crossings;
+                bestLayers = layering.layers;
+            }
+        }
+
+        layering.layers = bestLayers;
+        for(int r=0; r<nRanks; r++)
+            layering.updatePositions(r);
+    }
+
+    // x coordinates: one column per rank
+    std::vector<double> rankX(nRanks, 0.0);
+    std::vector<double> rankWidth(nRanks, 0.0);
+    for(int r=0; r<nRanks; r++)
+        for(auto v : layering.layers[r])
+            rankWidth[r] = std::max(rankWidth[r], layering.width[v]);
+    for(int r=1; r<nRanks; r++)
+        rankX[r] = rankX[r-1] + rankWidth[r-1] + rankSeparation;
+
+    // y coordinates: align vertices with their neighbors
+    const int nVertices = layering.width.size();
+    std::vector<double> centers(nVertices, 0.0);
+    {
+        std::vector<double> targets;
+        for(int r=0; r<nRanks; r++){
+            targets.assign(layering.layers[r].size(), 0.0);
+            placeLayer(layering, r, targets, centers, nodeSeparation);
+        }
+
+        const int nIterations = 8;
+        for(int i=0; i<nIterations; i++){
+            if(isCancelled())
+                return 0;
+
+            const bool useUp = i%2==0;
+            for(int k=0; k<nRanks; k++){
+                const int r = useUp ? k : nRanks-1-k;
+                const auto& vertices = layering.layers[r];
+                targets.resize(vertices.size());
+                for(size_t j=0; j<vertices.size(); j++){
+                    const int v = vertices[j];
+                    const auto& neighbors = useUp ? layering.up[v] : layering.down[v];
+                    targets[j] = centers[v];
+                    if(neighbors.size()>0){
+                        targets[j] = 0;
+                        for(auto w : neighbors)
+                            targets[j] += centers[w];
+                        targets[j] /= neighbors.size();
+                    }
+                }
+                placeLayer(layering, r, targets, centers, nodeSeparation);
+            }
+        }
+    }
+
+    // compute top left corners and move the layout to the origin
+    double minY = std::numeric_limits<double>::max();
+    for(int v=0; v<nNodes; v++){
+        result[v].first = rankX[rank[v]] + 0.5*(rankWidth[rank[v]]-layering.width[v]);
+        result[v].second = centers[v] - 0.5*layering.height[v];
+        minY = std::min(minY, result[v].second);
+    }
+    for(auto& p : result)
+        p.second -= minY;
+
+    return 1;
+}
+
+int NE::splitComponents(
+    const NE::LayoutGraph& graph,
+    std::vector<NE::LayoutGraph>& components,
+    std::vector<std::vector<int>>& indices
+){
+    const int nNodes = graph.nodes.size();
+
+    // union find with path halving
+    std::vector<int> parent(nNodes);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&](int v){
+        while(parent[v]!=v){
+            parent[v] = parent[parent[v]];
+            v = parent[v];
+        }
+        return v;
+    };
+    for(const auto& edge : graph.edges){
+        const int a = find(edge.producer);
+        const int b = find(edge.consumer);
+        if(a!=b)
+            parent[std::max(a,b)] = std::min(a,b);
+    }
+
+    components.clear();
+    indices.clear();
+
+    std::vector<int> componentOf(nNodes, -1);
+    std::vector<int> localIndex(nNodes, -1);
+    for(int v=0; v<nNodes; v++){
+        const int root = find(v);
+        if(componentOf[root]<0){
+            componentOf[root] = components.size();
+            components.emplace_back();
+            indices.emplace_back();
+        }
+        const int c = componentOf[root];
+        componentOf[v] = c;
+        localIndex[v] = components[c].nodes.size();
+        components[c].nodes.push_back(graph.nodes[v]);
+        indices[c].push_back(v);
+    }
+
+    for(const auto& edge : graph.edges)
+        components[ componentOf[edge.producer] ].edges.push_back({
+            localIndex[edge.producer],
+            localIndex[edge.consumer]
+        });
+
+    return 1;
+}
+
+int NE::computeLayeredLayouts(
+    const std::vector<NE::LayoutGraph>& graphs,
+    std::vector<NE::LayoutResult>& results,
+    std::vector<bool>& pending,
+    const std::atomic<bool>* cancelled,
+    double deadline
+){
+    results.resize(graphs.size());
+
+    // start with the largest graphs so that they do not end up last
+    std::vector<int> order;
+    for(size_t i=0; i<graphs.size(); i++)
+        if(pending[i])
+            order.push_back(i);
+    std::stable_sort(
+        order.begin(),
+        order.end(),
+        [&](int a, int b){
+            return graphs[a].nodes.size()>graphs[b].nodes.size();
+        }
+    );
+
+    // every thread writes the flags of the graphs it computed only
+    std::atomic<size_t> next{0};
+    std::atomic<bool> aborted{false};
+    std::vector<char> computed(order.size(), 0);
+    auto work = [&](){
+        for(size_t k=next++; k<order.size(); k=next++){
+            // always compute at least one graph, so that the layout progresses
+            if(k>0 && deadline>0 && NE::getTimeStamp()>deadline)
+                return;
+            if(!NE::computeLayeredLayout(graphs[order[k]], results[order[k]], cancelled))
+                aborted = true;
+            else
+                computed[k] = 1;
+        }
+    };
+
+    // helpers only use idle threads of the shared pool, so they are never
+    // queued behind other jobs, and the calling thread always takes part
+    auto pool = QThreadPool::globalInstance();
+    QSemaphore done;
+    int nHelpers = 0;
+    for(size_t t=1; t<order.size(); t++){
+        auto worker = new LayoutWorker(work, done);
+        if(!pool->tryStart(worker)){
+            delete worker;
+            break;
+        }
+        nHelpers++;
+    }
+    work();
+    done.acquire(nHelpers);
+
+    for(size_t k=0; k<order.size(); k++)
+        if(computed[k])
+            pending[order[k]] = false;
+
+    return aborted ? 0 : 1;
+}
+
+int NE::packComponents(
+    const std::vector<NE::LayoutGraph>& components,
+    const std::vector<NE::LayoutResult>& results,
+    const std::vector<std::vector<int>>& indices,
+    NE::LayoutResult& result
+){
+    const double separation = NE::CONSTS::LAYOUT_RANK_SEPARATION;
+
+    size_t nNodes = 0;
+    for(const auto& componentIndices : indices)
+        nNodes += componentIndices.size();
+    result.assign(nNodes, {0.0,0.0});
+
+    // bounding boxes of all components
+    const int nComponents = components.size();
+    std::vector<double> x0(nComponents), y0(nComponents), width(nComponents), height(nComponents);
+    double area = 0;
+    double maxWidth = 0;
+    for(int c=0; c<nComponents; c++){
+        double x1 = std::numeric_limits<double>::lowest();
+        double y1 = std::numeric_limits<double>::lowest();
+        x0[c] = std::numeric_limits<double>::max();
+        y0[c] = std::numeric_limits<double>::max();
+        for(size_t i=0; i<components[c].nodes.size(); i++){
+            const auto& p = results[c][i];
+            x0[c] = std::min(x0[c], p.first);
+            y0[c] = std::min(y0[c], p.second);
+            x1 = std::max(x1, p.first + components[c].nodes[i].width);
+            y1 = std::max(y1, p.second + components[c].nodes[i].height);
+        }
+        width[c] = x1-x0[c];
+        height[c] = y1-y0[c];
+        area += (width[c]+separation)*(height[c]+separation);
+        maxWidth = std::max(maxWidth, width[c]);
+    }
+
+    // place the components into rows of roughly square extent in the order
+    // of their smallest node, so that resizing a node does not reorder them
+    const double rowWidth = std::max(maxWidth, std::sqrt(area));
+    double x = 0;
+    double y = 0;
+    double rowHeight = 0;
+    for(int c=0; c<nComponents; c++){
+        if(x>0 && x+width[c]>rowWidth){
+            x = 0;
+            y += rowHeight + separation;
+            rowHeight = 0;
+        }
+
+        for(size_t i=0; i<indices[c].size(); i++){
+            const auto& p = results[c][i];
+            result[ indices[c][i] ] = { p.first-x0[c]+x, p.second-y0[c]+y };
+        }
+
+        x += width[c] + separation;
+        rowHeight = std::max(rowHeight, height[c]);
+    }
+
+    return 1;
+}
+
+int NE::computeComponentLayout(
+    const NE::LayoutGraph& graph,
+    NE::LayoutResult& result,
+    const std::atomic<bool>* cancelled
+){
+    std::vector<NE::LayoutGraph> components;
+    std::vector<std::vector<int>> indices;
+    NE::splitComponents(graph, components, indices);
+
+    std::vector<NE::LayoutResult> results;
+    std::vector<bool> pending(components.size(), true);
+    if(!NE::computeLayeredLayouts(components, results, pending, cancelled))
+        return 0;
+
+    return NE::packComponents(components, results, indices, result);
+}
+
+uint64_t NE::computeLayoutKey(const NE::LayoutGraph& graph, double quantization){
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ull;
+    auto add = [&](int64_t value){
+        for(int i=0; i<8; i++){
+            hash ^= (value>>(8*i)) & 0xff;
+            hash *= 1099511628211ull;
+        }
+    };
+
+    add(NE::CONSTS::LAYOUT_USE_GRAPHVIZ);
+    add(graph.nodes.size());
+    for(const auto& node : graph.nodes){
+        add(node.id);
+        add(std::llround(node.width/quantization));
+        add(std::llround(node.height/quantization));
+    }
+
+    // edges are identified by the ids of their nodes
+    std::vector<std::pair<int,int>> edges;
+    edges.reserve(graph.edges.size());
+    for(const auto& edge : graph.edges)
+        edges.emplace_back(
+            graph.nodes[edge.producer].id,
+            graph.nodes[edge.consumer].id
+        );
+    std::sort(edges.begin(), edges.end());
+
+    add(edges.size());
+    for(const auto& edge : edges){
+        add(edge.first);
+        add(edge.second);
+    }
+
+    return hash;
+}
+
+NE::LayoutCache::LayoutCache(size_t capacity) : capacity(capacity){
+}
+
+NE::LayoutCache::~LayoutCache(){
+}
+
+int NE::LayoutCache::get(uint64_t key, NE::LayoutResult& result){
+    auto it = this->index.find(key);
+    if(it==this->index.end())
+        return 0;
+
+    this->entries.splice(this->entries.begin(), this->entries, it->second);
+    result = it->second->second;
+    return 1;
+}
+
+int NE::LayoutCache::insert(uint64_t key, const NE::LayoutResult& result){
+    if(result.size()>this->capacity)
+        return 0;
+
+    auto it = this->index.find(key);
+    if(it!=this->index.end()){
+        this->size -= it->second->second.size();
+        this->entries.erase(it->second);
+        this->index.erase(it);
+    }
+
+    this->entries.emplace_front(key, result);
+    this->index[key] = this->entries.begin();
+    this->size += result.size();
+
+    while(this->size>this->capacity){
+        const auto& last = this->entries.back();
+        this->size -= last.second.size();
+        this->index.erase(last.first);
+        this->entries.pop_back();
+    }
+
+    return 1;
+}
+
+int NE::LayoutCache::clear(){
+    this->entries.clear();
+    this->index.clear();
+    this->size = 0;
+    return 1;
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+// std includes
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace NE {
+
+    /// Immutable description of a graph that is passed to the layout engines.
+    /// Nodes are boxes with variable size, and edges refer to the indices of
+    /// their producer and consumer nodes.
+    struct LayoutGraph {
+        struct Node {
+            int id;
+            double width;
+            double height;
+        };
+
+        struct Edge {
+            int producer;
+            int consumer;
+        };
+
+        std::vector<Node> nodes;
+        std::vector<Edge> edges;
+
+        // revision of the incrementally updated layout model at the time of
+        // the snapshot, see NE::GraphvizModel
+        unsigned int revision{0};
+    };
+
+    /// The top left corner of each node box, in the order of LayoutGraph::nodes.
+    using LayoutResult = std::vector<std::pair<double,double>>;
+
+    /// Computes a left-to-right layered (Sugiyama-style) layout directly on
+    /// the given graph in four phases:
+    /// * cycle removal and longest-path rank assignment;
+    /// * insertion of dummy nodes for edges that span several ranks;
+    /// * crossing reduction with alternating barycenter sweeps;
+    /// * coordinate assignment that aligns nodes with their neighbors while
+    ///   respecting the individual node heights.
+    /// Returns 0 if the computation was aborted via *cancelled*.
+    int computeLayeredLayout(
+        const LayoutGraph& graph,
+        LayoutResult& result,
+        const std::atomic<bool>* cancelled = nullptr
+    );
+
+    /// Splits a graph into its connected components. The i-th node of the
+    /// c-th component corresponds to the node indices[c][i] of the graph.
+    /// Components are ordered by their smallest node index.
+    int splitComponents(
+        const LayoutGraph& graph,
+        std::vector<LayoutGraph>& components,
+        std::vector<std::vector<int>>& indices
+    );
+
+    /// Computes the layered layouts of all graphs whose *pending* flag is set
+    /// concurrently on idle threads of the global thread pool and the calling
+    /// thread, and clears the flags of the computed graphs. The largest graphs
+    /// are started first. If a *deadline* (see NE::getTimeStamp) is given, no
+    /// graph is started after it, except for the first one, and the graphs
+    /// that were not started stay pending. Returns 0 if the computation was
+    /// aborted via *cancelled*.
+    int computeLayeredLayouts(
+        const std::vector<LayoutGraph>& graphs,
+        std::vector<LayoutResult>& results,
+        std::vector<bool>& pending,
+        const std::atomic<bool>* cancelled = nullptr,
+        double deadline = 0
+    );
+
+    /// Packs the layouts of the components of a graph next to each other in
+    /// rows (shelf packing) in the order of the components and returns the
+    /// positions of all graph nodes.
+    int packComponents(
+        const std::vector<LayoutGraph>& components,
+        const std::vector<LayoutResult>& results,
+        const std::vector<std::vector<int>>& indices,
+        LayoutResult& result
+    );
+
+    /// Lays out the connected components of a graph in parallel and packs
+    /// the results. Returns 0 if the computation was aborted via *cancelled*.
+    int computeComponentLayout(
+        const LayoutGraph& graph,
+        LayoutResult& result,
+        const std::atomic<bool>* cancelled = nullptr
+    );
+
+    /// Computes a deterministic hash of the topology of a graph and of its
+    /// node sizes, which are quantized to multiples of *quantization* pixels.
+    uint64_t computeLayoutKey(const LayoutGraph& graph, double quantization);
+
+    /// This class stores the results of previous layouts keyed by
+    /// computeLayoutKey. The cache holds at most *capacity* node positions and
+    /// evicts the least recently used results first.
+    class LayoutCache {
+
+        public:
+            LayoutCache(size_t capacity);
+            ~LayoutCache();
+
+            /// Copies a cached result and marks it as recently used.
+            /// Returns 0 if no result is stored for the key.
+            int get(uint64_t key, LayoutResult& result);
+
+            /// Stores a result and evicts old results if necessary.
+            int insert(uint64_t key, const LayoutResult& result);
+
+            int clear();
+
+        private:
+            using Entry = std::pair<uint64_t,LayoutResult>;
+
+            size_t capacity;
+            size_t size{0};
+
+            std::list<Entry> entries; // most recently used first
+            std::unordered_map<uint64_t,std::list<Entry>::iterator> index;
+    };
+}
@@ -0,0 +1,295 @@
+#include <LayoutScheduler.h>
+
+// node editor includes
+#include <Scene.h>
+#include <Node.h>
+#include <Graph.h>
+#include <Utils.h>
+
+// qt includes
+#include <QTimer>
+#include <QThreadPool>
+#include <QRunnable>
+
+// std includes
+#include <algorithm>
+#include <functional>
+#include <numeric>
+
+namespace {
+    class LayoutTask : public QRunnable {
+        public:
+            LayoutTask(std::function<void()> functor) : functor(functor){}
+            void run() override {
+                this->functor();
+            }
+        private:
+            std::function<void()> functor;
+    };
+}
+
+NE::LayoutScheduler::LayoutScheduler(
+    NE::Scene* scene,
+    NE::Graph& pipeline,
+    QObject* parent
+) :
+    QObject(parent),
+    scene(scene),
+    pipeline(pipeline),
+    cache(NE::CONSTS::LAYOUT_CACHE_CAPACITY)
+{
+    this->timer = new QTimer(this);
+    this->timer->setSingleShot(true);
+    QObject::connect(
+        this->timer, &QTimer::timeout,
+        this, &LayoutScheduler::run
+    );
+
+    // a cancelled job may still finish while its successor already runs
+    this->threadPool = new QThreadPool(this);
+    this->threadPool->setMaxThreadCount(2);
+
+    QObject::connect(
+        this, &LayoutScheduler::fullLayoutComputed,
+        this, &LayoutScheduler::applyFullLayout,
+        Qt::QueuedConnection
+    );
+}
+
+NE::LayoutScheduler::~LayoutScheduler(){
+    this->shutdown();
+}
+
+int NE::LayoutScheduler::shutdown(){
+    this->setEnabled(false);
+
+    // queued jobs are dropped and running jobs stop at their next check
+    this->threadPool->clear();
+    this->threadPool->waitForDone();
+
+    return 1;
+}
+
+int NE::LayoutScheduler::setEnabled(bool enabled){
+    this->enabled = enabled;
+    if(!this->enabled){
+        if(this->job)
+            this->job->cancelled = true;
+        this->job = nullptr;
+        this->timer->stop();
+        this->fullLayoutPending = false;
+        this->placedNodes.clear();
+        this->resizedNodes.clear();
+    }
+    return 1;
+}
+
+int NE::LayoutScheduler::markPlaced(int id){
+    if(!this->enabled)
+        return 0;
+
+    this->placedNodes.insert(id);
+    return this->requestLayout();
+}
+
+int NE::LayoutScheduler::markResized(int id){
+    if(!this->enabled)
+        return 0;
+
+    this->resizedNodes.insert(id);
+    return this->requestLayout();
+}
+
+int NE::LayoutScheduler::markRemoved(int id){
+    if(!this->enabled)
+        return 0;
+
+    // the result of a running full layout skips nodes that no longer exist,
+    // and the consumers of the node are placed again by the editor
+    this->placedNodes.erase(id);
+    this->resizedNodes.erase(id);
+    return this->requestLayout();
+}
+
+int NE::LayoutScheduler::requestLayout(){
+    if(!this->enabled)
+        return 0;
+
+    return this->schedule(0);
+}
+
+int NE::LayoutScheduler::requestFullLayout(){
+    if(!this->enabled)
+        return 0;
+
+    this->fullLayoutPending = true;
+    return this->schedule(0);
+}
+
+int NE::LayoutScheduler::schedule(double delay){
+    // all requests until the timer fires are merged into one run
+    if(this->timer->isActive())
+        return 1;
+
+    this->timer->start( std::max(0, int(delay*1000.0)) );
+    return 1;
+}
+
+int NE::LayoutScheduler::computeFullLayout(){
+    this->timer->stop();
+
+    // a full layout supersedes all pending requests and running jobs
+    this->fullLayoutPending = false;
+    this->placedNodes.clear();
+    this->resizedNodes.clear();
+    if(this->job)
+        this->job->cancelled = true;
+
+    auto job = std::make_shared<Job>();
+    job->generation = ++this->generation;
+    job->graph = this->scene->createLayoutGraph(this->pipeline);
+
+    // the graphviz model always lays out the whole graph as one component
+    const bool usesGraphviz = this->scene->usesGraphviz();
+    if(usesGraphviz){
+        job->components.push_back(job->graph);
+        job->indices.emplace_back(job->graph.nodes.size());
+        std::iota(job->indices[0].begin(), job->indices[0].end(), 0);
+    } else {
+        NE::splitComponents(job->graph, job->components, job->indices);
+    }
+
+    // look up the layouts of known components
+    const int nComponents = job->components.size();
+    job->results.resize(nComponents);
+    job->pending.assign(nComponents, true);
+    int nPending = 0;
+    for(int c=0; c<nComponents; c++){
+        job->keys.push_back(
+            NE::computeLayoutKey(job->components[c], NE::CONSTS::LAYOUT_CACHE_QUANTIZATION)
+        );
+        job->pending[c] = !this->cache.get(job->keys[c], job->results[c]);
+        nPending += job->pending[c];
+    }
+
+    // restore layouts of known configurations without a worker
+    if(nPending<1){
+        NE::log("Full Layout: cached");
+        this->job = nullptr;
+        NE::packComponents(job->components, job->results, job->indices, job->result);
+        this->scene->applyLayout(this->pipeline, job->graph, job->result);
+        emit this->fullLayoutApplied();
+        return 1;
+    }
+
+    this->job = job;
+    job->remaining = job->pending;
+
+    NE::log(
+        "Full Layout Started: "
+        +std::to_string(job->graph.nodes.size())+" nodes, "
+        +std::to_string(nPending)+"/"+std::to_string(nComponents)+" components"
+    );
+
+    // the worker only accesses the job and the thread-safe layout engines;
+    // the built-in engine stops starting components once the time budget is
+    // spent, and the remaining ones are computed by a continuation
+    auto scene = this->scene;
+    this->threadPool->start(
+        new LayoutTask(
+            [=](){
+                const double t0 = NE::getTimeStamp();
+                int status = 0;
+                if(usesGraphviz){
+                    status = scene->computeGraphLayout(job->components[0], job->results[0], &job->cancelled);
+                    job->remaining[0] = false;
+                } else {
+                    status = NE::computeLayeredLayouts(
+                        job->components, job->results, job->remaining,
+                        &job->cancelled, t0 + NE::CONSTS::LAYOUT_TIME_BUDGET
+                    );
+                }
+                if(!status)
+                    return;
+
+                if(std::none_of(job->remaining.begin(), job->remaining.end(), [](bool r){return r;}))
+                    NE::packComponents(job->components, job->results, job->indices, job->result);
+                job->duration = NE::getTimeStamp() - t0;
+                emit this->fullLayoutComputed(job->generation);
+            }
+        )
+    );
+
+    return 1;
+}
+
+int NE::LayoutScheduler::applyFullLayout(unsigned int generation){
+    // drop results that are out of date
+    if(!this->job || this->job->generation!=generation || this->job->cancelled)
+        return 0;
+
+    auto job = this->job;
+    this->job = nullptr;
+
+    NE::log("Full Layout: "+std::to_string(job->duration)+"s");
+
+    bool complete = true;
+    for(size_t c=0; c<job->components.size(); c++){
+        if(job->pending[c] && !job->remaining[c])
+            this->cache.insert(job->keys[c], job->results[c]);
+        complete = complete && !job->remaining[c];
+    }
+
+    // the computed components are cached, so the continuation only lays out
+    // the remaining ones
+    if(!complete){
+        NE::log("Full Layout: continued");
+        this->fullLayoutPending = true;
+        return this->schedule(0);
+    }
+
+    this->scene->applyLayout(this->pipeline, job->graph, job->result);
+
+    this->nextFullLayoutTime = job->duration>NE::CONSTS::LAYOUT_TIME_BUDGET
+        ? NE::getTimeStamp() + job->duration
+        : 0;
+
+    emit this->fullLayoutApplied();
+
+    // place the nodes that changed while the layout was computed
+    if(!this->placedNodes.empty() || !this->resizedNodes.empty())
+        this->requestLayout();
+
+    return 1;
+}
+
+int NE::LayoutScheduler::run(){
+    if(this->fullLayoutPending){
+        const double delay = this->nextFullLayoutTime - NE::getTimeStamp();
+        if(delay>0)
+            return this->schedule(delay);
+
+        return this->computeFullLayout();
+    }
+
+    // changes that arrive during a full layout are placed after it was
+    // applied, since its snapshot does not contain them
+    if(this->job)
+        return 1;
+
+    if(this->placedNodes.empty() && this->resizedNodes.empty())
+        return 1;
+
+    this->scene->computeIncrementalLayout(
+        this->pipeline,
+        this->placedNodes,
+        this->resizedNodes,
+        NE::getTimeStamp() + NE::CONSTS::LAYOUT_TIME_BUDGET
+    );
+
+    // continue with the remaining nodes in the next pass
+    if(!this->placedNodes.empty() || !this->resizedNodes.empty())
+        this->schedule(0);
+
+    return 1;
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+// qt includes
+#include <QObject>
+
+// node editor includes
+#include <Layout.h>
+
+// std includes
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// forward declarations
+class QTimer;
+class QThreadPool;
+
+namespace NE {
+    class Graph;
+    class Scene;
+}
+
+namespace NE {
+
+    /// This class coalesces all layout requests that are raised during one
+    /// pass of the event loop into a single layout update. Incremental updates
+    /// that exceed the time budget NE::CONSTS::LAYOUT_TIME_BUDGET are continued
+    /// in the next pass. A full layout job stops starting components once the
+    /// budget is spent and continues with the remaining components in a new
+    /// job, and full layouts that still exceed the budget delay the next full
+    /// layout by their own duration.
+    ///
+    /// Full layouts are computed on a worker thread on an immutable snapshot
+    /// of the graph and applied on the GUI thread in one pass. Nodes that are
+    /// placed or resized while a full layout runs are laid out incrementally
+    /// after it was applied, and nodes that were moved by hand keep their
+    /// position. The
+    /// built-in engine lays out connected components in parallel, and their
+    /// results are cached by topology and node sizes, so returning to a
+    /// configuration that was already laid out restores it instantly and
+    /// only changed components are recomputed.
+    class LayoutScheduler : public QObject {
+        Q_OBJECT
+
+        public:
+            LayoutScheduler(
+                NE::Scene* scene,
+                NE::Graph& pipeline,
+                QObject* parent=nullptr
+            );
+            ~LayoutScheduler();
+
+            /// Enables or disables automatic layout updates.
+            int setEnabled(bool enabled);
+            bool isEnabled(){return this->enabled;};
+
+            /// Disables the scheduler, cancels all full layouts and waits
+            /// for the worker threads. Has to be called before the scene is
+            /// destroyed.
+            int shutdown();
+
+        public slots:
+            /// Marks a node as created or rewired and requests a layout update.
+            int markPlaced(int id);
+
+            /// Marks a node as resized and requests a layout update.
+            int markResized(int id);
+
+            /// Notifies the scheduler that a node was removed.
+            int markRemoved(int id);
+
+            /// Requests an incremental layout update in the next event loop pass.
+            int requestLayout();
+
+            /// Requests a full layout in the next event loop pass.
+            int requestFullLayout();
+
+            /// Starts a full layout in the background and drops all pending
+            /// requests. Pinned nodes keep their position.
+            int computeFullLayout();
+
+        signals:
+            /// Emitted on the GUI thread after a full layout was applied.
+            void fullLayoutApplied();
+
+            /// Emitted by the worker thread when a full layout is computed.
+            void fullLayoutComputed(unsigned int generation);
+
+        protected slots:
+            int run();
+            int applyFullLayout(unsigned int generation);
+
+        private:
+            /// State of a full layout that is shared with the worker thread.
+            struct Job {
+                unsigned int generation{0};
+                std::atomic<bool> cancelled{false};
+                NE::LayoutGraph graph;
+                NE::LayoutResult result;
+                double duration{0};
+
+                // connected components and their cached or computed layouts
+                std::vector<NE::LayoutGraph> components;
+                std::vector<std::vector<int>> indices;
+                std::vector<uint64_t> keys;
+                std::vector<NE::LayoutResult> results;
+                std::vector<bool> pending;   // not cached
+                std::vector<bool> remaining; // not computed by the worker yet
+            };
+
+            int schedule(double delay);
+
+            NE::Scene* scene;
+            NE::Graph& pipeline;
+
+            QTimer* timer;
+            QThreadPool* threadPool;
+            bool enabled{true};
+
+            unsigned int generation{0};
+            std::shared_ptr<Job> job;
+            NE::LayoutCache cache;
+
+            bool fullLayoutPending{false};
+            double nextFullLayoutTime{0};
+
+            std::unordered_set<int> placedNodes;
+            std::unordered_set<int> resizedNodes;
+    };
+}
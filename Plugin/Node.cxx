@@ -3,6 +3,7 @@
 // node editor includes
 #include <Utils.h>
 #include <Port.h>
+#include <Scene.h>
 
 // qt includes
 #include <QPainter>
@@ -26,11 +27,15 @@
 #include <pqPipelineFilter.h>
 #include <pqDataRepresentation.h>
 #include <pqOutputPort.h>
+#include <pqActiveObjects.h>
 #include <vtkSMProxy.h>
+#include <vtkSMProperty.h>
+#include <vtkSMPropertyIterator.h>
+#include <vtkSmartPointer.h>
 
 #include <vtkSMPropertyGroup.h>
 
-NE::Node::Node(QGraphicsScene* scene, pqProxy* proxy, QGraphicsItem *parent) :
+NE::Node::Node(NE::Scene* scene, pqProxy* proxy, QGraphicsItem *parent) :
     QObject(),
     QGraphicsItem(parent),
     scene(scene),
@@ -110,15 +115,18 @@ NE::Node::Node(QGraphicsScene* scene, pqProxy* proxy, QGraphicsItem *parent) :
         auto containerLayout = new QVBoxLayout;
         this->widgetContainer->setLayout(containerLayout);
 
-        auto graphicsProxyWidget = new QGraphicsProxyWidget(this);
-        graphicsProxyWidget->setWidget( this->widgetContainer );
-        graphicsProxyWidget->setSizePolicy(QSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed));
+        this->graphicsProxyWidget = new QGraphicsProxyWidget(this);
+        this->graphicsProxyWidget->setWidget( this->widgetContainer );
+        this->graphicsProxyWidget->setSizePolicy(QSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed));
 
-        this->proxyProperties = new pqProxyWidget(this->proxy->getProxy());
-        this->proxyProperties->updatePanel();
-        containerLayout->addWidget(this->proxyProperties);
+        // property widgets are built on demand, until then a placeholder
+        // reserves their estimated space
+        this->placeholder = new QWidget;
+        containerLayout->addWidget(this->placeholder);
 
-        this->setVerbosity( NE::CONSTS::NODE_DEFAULT_VERBOSITY );
+        this->verbosity = std::max(std::min(NE::CONSTS::NODE_DEFAULT_VERBOSITY,2),0);
+        this->placeholder->setFixedHeight(this->estimatePropertiesHeight());
+        this->placeholder->setVisible(this->verbosity>0);
 
         this->updateSize();
     }
@@ -126,7 +134,7 @@ NE::Node::Node(QGraphicsScene* scene, pqProxy* proxy, QGraphicsItem *parent) :
     this->scene->addItem(this);
 }
 
-NE::Node::Node(QGraphicsScene* scene, pqPipelineSource* proxy, QGraphicsItem *parent) :
+NE::Node::Node(NE::Scene* scene, pqPipelineSource* proxy, QGraphicsItem *parent) :
     Node(scene, (pqProxy*)proxy, parent)
 {
     // create ports
@@ -137,7 +145,7 @@ NE::Node::Node(QGraphicsScene* scene, pqPipelineSource* proxy, QGraphicsItem *pa
 
         if(auto proxyAsFilter = dynamic_cast<pqPipelineFilter*>(proxy)){
             for(int i=0; i<proxyAsFilter->getNumberOfInputPorts(); i++){
-                auto iPort = new Port(0,proxyAsFilter->getInputPortName(i),this);
+                auto iPort = this->scene->getPortPool().acquire(0,proxyAsFilter->getInputPortName(i),this);
                 iPort->setPos(
                     br.left(),
                     -this->portContainerHeight + (i+0.5)*this->portHeight
@@ -147,7 +155,7 @@ NE::Node::Node(QGraphicsScene* scene, pqPipelineSource* proxy, QGraphicsItem *pa
         }
 
         for(int i=0; i<proxy->getNumberOfOutputPorts(); i++){
-            auto oPort = new Port(1,proxy->getOutputPort(i)->getPortName(),this);
+            auto oPort = this->scene->getPortPool().acquire(1,proxy->getOutputPort(i)->getPortName(),this);
             oPort->setPos(
                 br.right(),
                 -this->portContainerHeight + (i+0.5)*this->portHeight
@@ -156,15 +164,6 @@ NE::Node::Node(QGraphicsScene* scene, pqPipelineSource* proxy, QGraphicsItem *pa
         }
     }
 
-    // create property widgets
-    QObject::connect(
-        this->proxyProperties, &pqProxyWidget::changeFinished,
-        this, [=](){
-            NE::log("Source/Filter Property Modified: "+NE::getLabel(this->proxy));
-            this->proxy->setModifiedState(pqProxy::MODIFIED);
-            return 1;
-        }
-    );
     QObject::connect(
         this->proxy, &pqProxy::modifiedStateChanged,
         this, [=](){
@@ -177,7 +176,7 @@ NE::Node::Node(QGraphicsScene* scene, pqPipelineSource* proxy, QGraphicsItem *pa
     );
 }
 
-NE::Node::Node(QGraphicsScene* scene, pqView* proxy, QGraphicsItem *parent) :
+NE::Node::Node(NE::Scene* scene, pqView* proxy, QGraphicsItem *parent) :
     Node(scene, (pqProxy*)proxy, parent)
 {
     auto br = this->boundingRect();
@@ -185,30 +184,93 @@ NE::Node::Node(QGraphicsScene* scene, pqView* proxy, QGraphicsItem *parent) :
     br.adjust(adjust,adjust,-adjust,-adjust);
 
     // create port
-    auto iPort = new Port(2,"",this);
+    auto iPort = this->scene->getPortPool().acquire(2,"",this);
     iPort->setPos(
         br.center().x(),
         br.top()
     );
     this->iPorts.push_back( iPort );
-
-    // create property widgets
-    QObject::connect(
-        this->proxyProperties, &pqProxyWidget::changeFinished,
-        this, [=](){
-            NE::log("View Property Modified: "+NE::getLabel(this->proxy));
-            this->proxy->setModifiedState(pqProxy::MODIFIED);
-            this->proxyProperties->apply();
-            ((pqView*)this->proxy)->render();
-        }
-    );
 }
 
 NE::Node::~Node(){
     NE::log(" -Node: "+NE::getLabel(this->proxy));
+
+    // hand the ports to later nodes instead of deleting them with this item
+    for(auto port: this->iPorts)
+        this->scene->getPortPool().release(port);
+    for(auto port: this->oPorts)
+        this->scene->getPortPool().release(port);
+
     this->scene->removeItem(this);
 }
 
+int NE::Node::createProxyProperties(){
+    if(this->proxyProperties)
+        return 1;
+
+    NE::log("  +Properties: "+NE::getLabel(this->proxy));
+
+    auto proxyAsView = dynamic_cast<pqView*>(this->proxy);
+
+    this->proxyProperties = new pqProxyWidget(this->proxy->getProxy());
+    if(!proxyAsView)
+        this->proxyProperties->setView(pqActiveObjects::instance().activeView());
+    this->viewPending = false;
+    this->proxyProperties->updatePanel();
+
+    // the widget only takes the space that the placeholder reserved
+    this->replacingPlaceholder = !this->placeholder->isHidden();
+    this->placeholderEstimated = false;
+    this->placeholder->hide();
+    this->widgetContainer->layout()->addWidget(this->proxyProperties);
+
+    if(proxyAsView){
+        QObject::connect(
+            this->proxyProperties, &pqProxyWidget::changeFinished,
+            this, [=](){
+                NE::log("View Property Modified: "+NE::getLabel(this->proxy));
+                this->proxy->setModifiedState(pqProxy::MODIFIED);
+                this->proxyProperties->apply();
+                proxyAsView->render();
+            }
+        );
+    } else {
+        QObject::connect(
+            this->proxyProperties, &pqProxyWidget::changeFinished,
+            this, [=](){
+                NE::log("Source/Filter Property Modified: "+NE::getLabel(this->proxy));
+                this->proxy->setModifiedState(pqProxy::MODIFIED);
+                return 1;
+            }
+        );
+    }
+
+    this->filterProxyProperties();
+
+    return 1;
+}
+
+int NE::Node::releaseProxyProperties(){
+    if(!this->proxyProperties)
+        return 1;
+
+    // uncommitted values only live in the widget
+    if(this->proxy->modifiedState()!=pqProxy::UNMODIFIED)
+        return 0;
+
+    NE::log("  -Properties: "+NE::getLabel(this->proxy));
+
+    // keep the geometry stable
+    this->placeholder->setFixedHeight(this->proxyProperties->height());
+    this->placeholder->setVisible(this->verbosity>0);
+
+    this->widgetContainer->layout()->removeWidget(this->proxyProperties);
+    this->proxyProperties->deleteLater();
+    this->proxyProperties = nullptr;
+
+    return 1;
+}
+
 int NE::Node::updateSize(){
     this->widgetContainer->resize(
         this->widgetContainer->layout()->sizeHint()
@@ -220,11 +282,40 @@ int NE::Node::updateSize(){
     this->widgetContainerHeight = this->widgetContainer->height();
 
     emit this->nodeResized();
+    this->replacingPlaceholder = false;
 
     return 1;
 }
 
+int NE::Node::estimatePropertiesHeight(){
+    if(this->verbosity<1)
+        return 0;
+
+    // count the properties that the widget shows at the current verbosity
+    int nProperties = 0;
+    auto iterator = vtkSmartPointer<vtkSMPropertyIterator>::Take(
+        this->proxy->getProxy()->NewPropertyIterator()
+    );
+    for(iterator->Begin(); !iterator->IsAtEnd(); iterator->Next()){
+        auto property = iterator->GetProperty();
+        if(!property || property->GetInformationOnly() || property->GetIsInternal())
+            continue;
+
+        const std::string visibility = property->GetPanelVisibility()
+            ? property->GetPanelVisibility()
+            : "default";
+        if(visibility=="default" || (visibility=="advanced" && this->verbosity>1))
+            nProperties++;
+    }
+
+    return nProperties>0
+        ? nProperties*NE::CONSTS::NODE_PROPERTY_HEIGHT
+        : NE::CONSTS::NODE_PLACEHOLDER_HEIGHT;
+}
+
 int NE::Node::setOutlineStyle(int style){
+    if(this->outlineStyle==style)
+        return 1;
     this->outlineStyle = style;
     this->update(this->boundingRect());
     return 1;
@@ -235,6 +326,85 @@ int NE::Node::setBackgroundStyle(int style){
     return 1;
 }
 
+int NE::Node::setHeat(double heat, QString annotation){
+    if(this->heat==heat && this->heatAnnotation==annotation)
+        return 1;
+    this->heat = heat;
+    this->heatAnnotation = annotation;
+    this->update(this->boundingRect());
+    return 1;
+}
+
+int NE::Node::setMemoryFlag(bool flagged){
+    if(this->memoryFlagged==flagged)
+        return 1;
+    this->memoryFlagged = flagged;
+    this->update(this->boundingRect());
+    return 1;
+}
+
+int NE::Node::setCritical(bool critical){
+    if(this->critical==critical)
+        return 1;
+    this->critical = critical;
+    this->update(this->boundingRect());
+    return 1;
+}
+
+int NE::Node::setApplyState(int state){
+    if(this->applyState==state)
+        return 1;
+    this->applyState = state;
+    this->update(this->boundingRect());
+    return 1;
+}
+
+int NE::Node::setPinned(bool pinned){
+    this->pinned = pinned;
+    return 1;
+}
+
+int NE::Node::setLevelOfDetail(int level){
+    if(this->levelOfDetail==level)
+        return 1;
+
+    // the widgets may change at full detail, so the snapshot is taken again
+    // by the next paint at reduced detail; it is kept at minimal detail for
+    // zooming back in
+    if(level==0)
+        this->widgetSnapshot = QPixmap();
+
+    this->levelOfDetail = level;
+    this->graphicsProxyWidget->setVisible(level==0);
+
+    if(level==0 && this->visibleInViewport && this->verbosity>0)
+        this->createProxyProperties();
+    this->applyPendingView();
+
+    for(auto port: this->iPorts)
+        port->setLevelOfDetail(level);
+    for(auto port: this->oPorts)
+        port->setLevelOfDetail(level);
+
+    this->update(this->boundingRect());
+
+    return 1;
+}
+
+int NE::Node::updateWidgetSnapshot(){
+    if(this->widgetContainerHeight<1)
+        return 0;
+
+    // the hidden widgets are rendered into the pixmap only
+    auto snapshot = this->widgetContainer->grab();
+    this->widgetSnapshot = snapshot.scaled(
+        snapshot.size()*NE::CONSTS::LOD_REDUCED_SCALE,
+        Qt::IgnoreAspectRatio,
+        Qt::SmoothTransformation
+    );
+    return 1;
+}
+
 int NE::Node::getVerbosity(){
     return this->verbosity;
 }
@@ -244,6 +414,60 @@ int NE::Node::setVerbosity(int verbosity){
     if(this->verbosity>2)
         this->verbosity = 0;
 
+    // expanding a node builds its property widget
+    if(this->verbosity>0)
+        this->createProxyProperties();
+    this->applyPendingView();
+
+    return this->filterProxyProperties();
+}
+
+int NE::Node::setVisibleInViewport(bool visible){
+    this->visibleInViewport = visible;
+    if(visible && this->verbosity>0 && this->levelOfDetail==0)
+        this->createProxyProperties();
+    this->applyPendingView();
+    return 1;
+}
+
+int NE::Node::setView(pqView* view){
+    if(dynamic_cast<pqView*>(this->proxy))
+        return 0;
+
+    // the widget is built for the active view anyway
+    if(!this->proxyProperties)
+        return 1;
+
+    this->view = view;
+    this->viewPending = true;
+    return this->applyPendingView();
+}
+
+int NE::Node::applyPendingView(){
+    if(
+        !this->viewPending
+        || !this->proxyProperties
+        || !this->visibleInViewport
+        || this->verbosity<1
+        || this->levelOfDetail>0
+    )
+        return 0;
+
+    NE::log("  View Changed: "+NE::getLabel(this->proxy));
+
+    this->viewPending = false;
+    this->proxyProperties->setView(this->view);
+    return this->filterProxyProperties();
+}
+
+int NE::Node::filterProxyProperties(){
+    if(!this->proxyProperties){
+        if(this->placeholderEstimated)
+            this->placeholder->setFixedHeight(this->estimatePropertiesHeight());
+        this->placeholder->setVisible(this->verbosity>0);
+        return 1;
+    }
+
     if(this->verbosity==0)
         this->proxyProperties->filterWidgets(false, "%%%%%%%%%%%%%%");
     else if(this->verbosity==1)
@@ -266,6 +490,17 @@ QVariant NE::Node::itemChange(GraphicsItemChange change, const QVariant &value){
     return QGraphicsItem::itemChange(change, value);
 }
 
+void NE::Node::mousePressEvent(QGraphicsSceneMouseEvent *event){
+    this->pressPos = this->pos();
+    QGraphicsItem::mousePressEvent(event);
+}
+
+void NE::Node::mouseReleaseEvent(QGraphicsSceneMouseEvent *event){
+    QGraphicsItem::mouseReleaseEvent(event);
+    if(this->pos()!=this->pressPos)
+        this->setPinned(true);
+}
+
 QRectF NE::Node::boundingRect() const {
     auto offset = NE::CONSTS::NODE_BORDER_WIDTH;
     auto br = QRectF(
@@ -304,4 +539,66 @@ void NE::Node::paint(QPainter *painter, const QStyleOptionGraphicsItem *option,
             : palette.window()
     );
     painter->drawPath(path);
+
+    // heat map overlay from green (cold) to red (hot)
+    if(this->heat>=0){
+        auto color = QColor::fromHsvF( (1.0-std::min(this->heat,1.0))/3.0, 0.8, 0.9 );
+        color.setAlphaF(0.5);
+        painter->fillPath(path, color);
+
+        painter->setPen(palette.text().color());
+        painter->drawText(
+            QRectF(br.left(), br.top(), br.width()-24, this->labelHeight),
+            Qt::AlignRight | Qt::AlignVCenter,
+            this->heatAnnotation
+        );
+    }
+
+    // tint the title of nodes above the memory threshold
+    if(this->memoryFlagged){
+        auto color = NE::CONSTS::COLOR_RED;
+        color.setAlphaF(0.4);
+        QPainterPath title;
+        title.addRect(br.left(), br.top(), br.width(), this->labelHeight);
+        painter->fillPath(title.intersected(path), color);
+    }
+
+    // critical path marker inside the border
+    if(this->critical){
+        const int inset = NE::CONSTS::NODE_BORDER_WIDTH;
+        painter->setPen(QPen(NE::CONSTS::COLOR_RED, NE::CONSTS::NODE_BORDER_WIDTH));
+        painter->setBrush(Qt::NoBrush);
+        painter->drawRoundedRect(
+            br.adjusted(inset,inset,-inset,-inset),
+            NE::CONSTS::NODE_BORDER_RADIUS,
+            NE::CONSTS::NODE_BORDER_RADIUS
+        );
+    }
+
+    if(this->levelOfDetail==1 && this->widgetSnapshot.isNull())
+        this->updateWidgetSnapshot();
+    if(this->levelOfDetail==1 && !this->widgetSnapshot.isNull())
+        painter->drawPixmap(
+            QRectF(0, 0, this->widgetContainerWidth, this->widgetContainerHeight),
+            this->widgetSnapshot,
+            QRectF(this->widgetSnapshot.rect())
+        );
+
+    // apply state indicator in the top right corner
+    if(this->applyState>0){
+        const int radius = 6;
+        painter->setPen(Qt::NoPen);
+        painter->setBrush(
+            this->applyState==1
+                ? palette.mid()
+                : this->applyState==2
+                    ? QBrush(NE::CONSTS::COLOR_ORANGE)
+                    : QBrush(NE::CONSTS::COLOR_GREEN)
+        );
+        painter->drawEllipse(
+            QPointF(br.right()-2*radius, br.top()+2*radius),
+            radius,
+            radius
+        );
+    }
 }
\ No newline at end of file
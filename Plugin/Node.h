@@ -2,17 +2,20 @@
 
 // QT includes
 #include <QGraphicsItem>
+#include <QPixmap>
+#include <QPointer>
 
 // forward declarations
 class pqProxy;
 class pqProxyWidget;
 class pqView;
 class pqPipelineSource;
-class QGraphicsScene;
 class QGraphicsSceneMouseEvent;
+class QGraphicsProxyWidget;
 
 namespace NE {
     class Port;
+    class Scene;
 }
 
 namespace NE {
@@ -22,16 +25,16 @@ namespace NE {
 
         public:
 
-            Node(QGraphicsScene* scene, pqProxy* proxy, QGraphicsItem *parent = nullptr);
+            Node(NE::Scene* scene, pqProxy* proxy, QGraphicsItem *parent = nullptr);
 
             /// Creates a node for a pqPipelineSource that consists of
             /// * an encapsulating rectangle
             /// * input and output ports
             /// * a widgetContainer for properties
-            Node(QGraphicsScene* scene, pqPipelineSource* source, QGraphicsItem *parent = nullptr);
+            Node(NE::Scene* scene, pqPipelineSource* source, QGraphicsItem *parent = nullptr);
 
             /// TODO
-            Node(QGraphicsScene* scene, pqView* view, QGraphicsItem *parent = nullptr);
+            Node(NE::Scene* scene, pqView* view, QGraphicsItem *parent = nullptr);
 
             /// Destructor
             ~Node();
@@ -56,11 +59,21 @@ namespace NE {
                 return this->oPorts;
             }
 
-            /// Get widget container of the node.
+            /// Get the property widget of the node. Property widgets are
+            /// built lazily, so this returns nullptr until the node was
+            /// expanded or became visible.
             pqProxyWidget* getProxyProperties(){
                 return this->proxyProperties;
             }
 
+            /// Builds the property widget if it does not exist yet.
+            int createProxyProperties();
+
+            /// Destroys the property widget and replaces it with a
+            /// placeholder of the same size. Widgets of proxies with
+            /// modified or uninitialized state are kept, and 0 is returned.
+            int releaseProxyProperties();
+
             /// Get widget container of the node.
             QGraphicsTextItem* getLabel(){
                 return this->label;
@@ -72,6 +85,16 @@ namespace NE {
             int getVerbosity();
             int setVerbosity(int i);
 
+            /// Marks whether the node intersects the viewport of the view.
+            /// Visible expanded nodes build their property widget.
+            int setVisibleInViewport(bool visible);
+            bool isVisibleInViewport(){return this->visibleInViewport;};
+
+            /// Sets the view whose representation the property widget of a
+            /// source or filter shows. The view is applied immediately if
+            /// the widget is shown, and otherwise once it becomes visible.
+            int setView(pqView* view);
+
             // sets the type of the node (0:normal, 1: selected filter, 2: selected view)
             int setOutlineStyle(int style);
             int getOutlineStyle(){return this->outlineStyle;};
@@ -79,6 +102,41 @@ namespace NE {
             int setBackgroundStyle(int style);
             int getBackgroundStyle(){return this->backgroundStyle;};
 
+            /// Sets the heat of the node in [0,1] and the annotation shown in
+            /// its title. A negative heat disables the heat map overlay.
+            int setHeat(double heat, QString annotation="");
+            double getHeat(){return this->heat;};
+
+            /// Marks the node as holding more output data than the memory
+            /// threshold.
+            int setMemoryFlag(bool flagged);
+            bool isMemoryFlagged(){return this->memoryFlagged;};
+
+            /// Marks the node as part of the critical path.
+            int setCritical(bool critical);
+            bool isCritical(){return this->critical;};
+
+            // sets the apply state of the node (0: idle, 1: pending, 2: running, 3: done)
+            int setApplyState(int state);
+            int getApplyState(){return this->applyState;};
+
+            /// A node is pinned if it was moved by hand. Incremental layouts
+            /// keep pinned nodes at their current position.
+            int setPinned(bool pinned);
+            bool isPinned(){return this->pinned;};
+
+            /// Sets the level of detail (0: full, 1: reduced, 2: minimal).
+            /// Below full detail the property widgets are hidden and the
+            /// node either paints a snapshot of its widgets (reduced) or only
+            /// a titled box with port dots (minimal).
+            int setLevelOfDetail(int level);
+            int getLevelOfDetail(){return this->levelOfDetail;};
+
+            /// Returns true while nodeResized is emitted because the property
+            /// widget replaced its placeholder. Such resizes only correct the
+            /// estimated size and do not require a layout update.
+            bool isReplacingPlaceholder(){return this->replacingPlaceholder;};
+
             QRectF boundingRect() const override;
 
         signals:
@@ -87,24 +145,61 @@ namespace NE {
 
         protected:
 
+            int filterProxyProperties();
+
+            /// Applies a pending view if the property widget is shown.
+            int applyPendingView();
+
+            /// Estimates the height of the property widget from the number
+            /// of properties shown at the current verbosity, so that the
+            /// node keeps its size when the widget is built.
+            int estimatePropertiesHeight();
+
+            /// Renders the property widgets into the snapshot that is painted
+            /// at reduced detail. Only called by paint, so that only nodes in
+            /// the viewport pay for it.
+            int updateWidgetSnapshot();
+
             QVariant itemChange(GraphicsItemChange change, const QVariant &value) override;
 
+            void mousePressEvent(QGraphicsSceneMouseEvent *event) override;
+            void mouseReleaseEvent(QGraphicsSceneMouseEvent *event) override;
+
             void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override;
 
         private:
-            QGraphicsScene* scene;
+            NE::Scene* scene;
             pqProxy* proxy;
-            pqProxyWidget* proxyProperties;
+            pqProxyWidget* proxyProperties{nullptr};
             QWidget* widgetContainer;
+            QWidget* placeholder;
+            QGraphicsProxyWidget* graphicsProxyWidget;
             QGraphicsTextItem* label;
 
+            int levelOfDetail{0};
+            bool visibleInViewport{false};
+            QPixmap widgetSnapshot;
+            bool placeholderEstimated{true};
+            bool replacingPlaceholder{false};
+
+            QPointer<pqView> view;
+            bool viewPending{false};
+
             std::vector<NE::Port*> iPorts;
             std::vector<NE::Port*> oPorts;
 
             int outlineStyle{0}; // 0: normal, 1: selected filter, 2: selected view
             int backgroundStyle{0}; // 0: normal, 1: modified
+            int applyState{0}; // 0: idle, 1: pending, 2: running, 3: done
+            double heat{-1};
+            QString heatAnnotation;
+            bool critical{false};
+            bool memoryFlagged{false};
             int verbosity{0}; // 0: empty, 1: non-advanced, 2: advanced
 
+            bool pinned{false};
+            QPointF pressPos;
+
             int labelHeight{30};
 
             int portHeight{24};
@@ -2,7 +2,11 @@
 
 // node editor includes
 #include <Scene.h>
+#include <Graph.h>
 #include <View.h>
+#include <LayoutScheduler.h>
+#include <ApplyQueue.h>
+#include <DataInfoCache.h>
 #include <Node.h>
 #include <Edge.h>
 #include <Port.h>
@@ -15,6 +19,12 @@
 #include <QSpacerItem>
 #include <QPushButton>
 #include <QCheckBox>
+#include <QLabel>
+#include <QComboBox>
+#include <QToolTip>
+#include <QGraphicsSceneHelpEvent>
+#include <QSpinBox>
+#include <QTimer>
 #include <QEvent>
 #include <QAction>
 #include <iostream>
@@ -40,13 +50,22 @@
 #include <vtkSMViewProxy.h>
 #include <vtkSMSourceProxy.h>
 #include <vtkSMTrace.h>
+#include <vtkPVDataInformation.h>
+#include <vtkClientServerStream.h>
+#include <vtkSMOutputPort.h>
+#include <vtkSMSession.h>
 
 // for state files
 #include <vtkPVXMLElement.h>
 #include <vtkSMProxyLocator.h>
 
 // std include
+#include <algorithm>
+#include <cmath>
+#include <functional>
 #include <iostream>
+#include <map>
+#include <unordered_set>
 
 // TODO
 #include <vtkSMPropertyIterator.h>
@@ -61,8 +80,9 @@ NodeEditor::NodeEditor(const QString &title, QWidget *parent)
     auto layout = new QVBoxLayout;
     widget->setLayout(layout);
 
-    // create node editor scene and view
+    // create node editor graph, scene and view
     this->scene = new NE::Scene(this);
+    this->graph = new NE::Graph(this->scene);
     this->view = new NE::View(
         this->scene,
         this
@@ -71,8 +91,69 @@ NodeEditor::NodeEditor(const QString &title, QWidget *parent)
     this->view->setSceneRect(-10000,-10000,30000,30000);
     layout->addWidget(this->view);
 
+    // propagate the level of detail of the view to all nodes
+    QObject::connect(
+        this->view, &NE::View::levelOfDetailChanged,
+        this, [=](int level){
+            for(auto it: this->graph->getNodes())
+                it.second->setLevelOfDetail(level);
+        }
+    );
+
+    this->layoutScheduler = new NE::LayoutScheduler(
+        this->scene,
+        *this->graph,
+        this
+    );
+
+    this->applyQueue = new NE::ApplyQueue(*this->graph, this);
+    QObject::connect(
+        this->applyQueue, &NE::ApplyQueue::nodeUpdated,
+        this, &NodeEditor::recordExecution
+    );
+
+    this->dataInfoCache = new NE::DataInfoCache(this);
+    QObject::connect(
+        this->dataInfoCache, &NE::DataInfoCache::infoUpdated,
+        this, [=](pqPipelineSource* source){
+            this->requestMemoryPanelUpdate();
+            this->updateProfileMemory( NE::getID(source) );
+            return this->updateEdgeWeights( NE::getID(source) );
+        }
+    );
+
+    // show the data volume of the edge under the cursor
+    this->scene->installEventFilter(
+        NE::createInterceptor(
+            this->scene,
+            [=](QObject* object, QEvent* event){
+                if(event->type()!=QEvent::GraphicsSceneHelp)
+                    return false;
+                auto helpEvent = static_cast<QGraphicsSceneHelpEvent*>(event);
+
+                NE::Edge* edge = nullptr;
+                for(int type : {1,0})
+                    if(!edge)
+                        edge = this->scene->getEdgeLayer(type)->getEdgeAt(helpEvent->scenePos());
+                if(!edge)
+                    return false;
+
+                QToolTip::showText(helpEvent->screenPos(), this->getEdgeToolTip(edge));
+                return true;
+            }
+        )
+    );
+
+    this->journal = new NE::ChangeJournal(this);
+    QObject::connect(
+        this->journal, &NE::ChangeJournal::changesReady,
+        this, &NodeEditor::applyChanges
+    );
+
     this->initializeActions();
     this->createToolbar(layout);
+    this->memoryThreshold = NE::CONSTS::MEMORY_THRESHOLD;
+    this->createMemoryPanel(layout);
 
     this->attachServerManagerListeners();
 
@@ -83,39 +164,57 @@ NodeEditor::NodeEditor(QWidget *parent) : NodeEditor("Node Editor", parent){
 }
 
 NodeEditor::~NodeEditor(){
+    // workers still refer to the scene, which is destroyed before the
+    // scheduler as it was created first
+    this->layoutScheduler->shutdown();
+    delete this->graph;
 }
 
 int NodeEditor::apply(){
-    auto nodes = this->nodeRegistry;
-    for(auto it: nodes){
-        auto proxy = dynamic_cast<pqPipelineSource*>(
-            it.second->getProxy()
-        );
-        if(proxy){
-            NE::log("Apply Properties: "+NE::getLabel(proxy));
-            it.second->getProxyProperties()->apply();
-            proxy->setModifiedState( pqProxy::ModifiedState::UNMODIFIED );
-        }
-    }
-    for(auto it: nodes){
-        auto proxy = dynamic_cast<pqPipelineSource*>(
-            it.second->getProxy()
-        );
-        if(proxy){
-            NE::log("Update Pipeline: "+NE::getLabel(proxy));
-            proxy->updatePipeline();
-        }
-    }
-    for(auto it: nodes){
-        auto proxy = dynamic_cast<pqView*>(
-            it.second->getProxy()
-        );
-        if(proxy){
-            NE::log("Update View: "+NE::getLabel(proxy));
-            proxy->render();
-        }
+    // collect modified and uninitialized sources and filters
+    std::vector<int> modified;
+    for(auto ids : {&this->graph->getSources(), &this->graph->getFilters()})
+        for(auto id : *ids)
+            if(this->graph->getNode(id)->getProxy()->modifiedState()!=pqProxy::ModifiedState::UNMODIFIED)
+                modified.push_back(id);
+
+    // only the modified nodes and their consumers have to be updated
+    const auto affected = this->graph->getDownstream(modified);
+
+    // ids are copied, since applying properties may modify the graph
+    for(auto id: modified){
+        auto node = this->graph->getNode(id);
+        if(!node)
+            continue;
+        auto proxy = node->getProxy();
+        NE::log("Apply Properties: "+NE::getLabel(proxy));
+        if(auto properties = node->getProxyProperties())
+            properties->apply();
+        else
+            proxy->getProxy()->UpdateVTKObjects();
+        proxy->setModifiedState( pqProxy::ModifiedState::UNMODIFIED );
     }
 
+    // producers come first, so every pipeline executes once, followed by
+    // the views that show an affected output port
+    std::set<int> views;
+    for(auto id: affected)
+        for(auto edge : this->graph->getOutgoingEdges(id))
+            if(edge->getType()==1)
+                views.insert( NE::getID(edge->getConsumer()->getProxy()) );
+
+    // the active source is shown once all updates are done
+    this->applyQueue->enqueue(
+        affected,
+        std::vector<int>(views.begin(), views.end())
+    );
+    if(!this->applyQueue->isRunning())
+        return this->showActiveSource();
+
+    return 1;
+}
+
+int NodeEditor::showActiveSource(){
     auto activeView = pqActiveObjects::instance().activeView();
     if(!activeView)
         return 1;
@@ -145,13 +244,13 @@ int NodeEditor::apply(){
 }
 
 int NodeEditor::reset(){
-    for(auto it: this->nodeRegistry){
-        auto proxy = dynamic_cast<pqPipelineSource*>(
-            it.second->getProxy()
-        );
-        if(proxy){
+    for(auto ids : {&this->graph->getSources(), &this->graph->getFilters()}){
+        for(auto id : *ids){
+            auto node = this->graph->getNode(id);
+            auto proxy = node->getProxy();
             NE::log("Reset Properties: "+NE::getLabel(proxy));
-            it.second->getProxyProperties()->reset();
+            if(auto properties = node->getProxyProperties())
+                properties->reset();
             proxy->setModifiedState( pqProxy::ModifiedState::UNMODIFIED );
         }
     }
@@ -160,12 +259,15 @@ int NodeEditor::reset(){
 
 int NodeEditor::zoom(){
     const int padding = 20;
-    auto viewPort = this->scene->getBoundingRect(this->nodeRegistry);
+    auto viewPort = this->scene->getBoundingRect(this->graph->getNodes());
     viewPort.adjust(-padding,-padding,padding,padding);
     this->view->fitInView(
         viewPort,
         Qt::KeepAspectRatio
     );
+    this->view->resetCachedContent();
+    this->view->updateLevelOfDetail();
+    this->view->requestVisibleNodesUpdate();
     return 1;
 }
 
@@ -176,6 +278,29 @@ int NodeEditor::initializeActions(){
         this, &NodeEditor::apply
     );
 
+    this->actionCancel = new QAction(this);
+    this->actionCancel->setEnabled(false);
+    QObject::connect(
+        this->actionCancel, &QAction::triggered,
+        this->applyQueue, &NE::ApplyQueue::cancel
+    );
+    QObject::connect(
+        this->applyQueue, &NE::ApplyQueue::started,
+        this, [=](){
+            this->actionCancel->setEnabled(true);
+            this->profile.startRun();
+        }
+    );
+    QObject::connect(
+        this->applyQueue, &NE::ApplyQueue::finished,
+        this, [=](bool cancelled){
+            this->actionCancel->setEnabled(false);
+            this->updateCriticalPath();
+            if(!cancelled)
+                this->showActiveSource();
+        }
+    );
+
     this->actionReset = new QAction(this);
     QObject::connect(
         this->actionReset, &QAction::triggered,
@@ -191,23 +316,26 @@ int NodeEditor::initializeActions(){
     this->actionLayout = new QAction(this);
     QObject::connect(
         this->actionLayout, &QAction::triggered,
-        this->scene, [=](){
-            this->scene->computeLayout(
-                this->nodeRegistry,
-                this->edgeRegistry
-            );
-            return 1;
+        this, [=](){
+            // only an explicit layout repositions nodes that were moved by hand
+            for(auto it : this->graph->getNodes())
+                it.second->setPinned(false);
+            return this->layoutScheduler->computeFullLayout();
+        }
+    );
+    QObject::connect(
+        this->layoutScheduler, &NE::LayoutScheduler::fullLayoutApplied,
+        this, [=](){
+            if(this->zoomAfterLayout)
+                this->actionZoom->trigger();
+            this->zoomAfterLayout = false;
         }
     );
 
     this->actionAutoLayout = new QAction(this);
     QObject::connect(
         this->actionAutoLayout, &QAction::triggered,
-        this->scene, [=](){
-            if(this->autoUpdateLayout)
-                this->actionLayout->trigger();
-            return 1;
-        }
+        this->layoutScheduler, &NE::LayoutScheduler::requestLayout
     );
 
     this->actionCollapseAllNodes = new QAction(this);
@@ -237,17 +365,32 @@ int NodeEditor::createToolbar(QLayout* layout){
     };
 
     addButton("Apply", this->actionApply);
+    {
+        auto button = new QPushButton("Cancel");
+        button->setEnabled(this->actionCancel->isEnabled());
+        this->connect(
+            button, &QPushButton::released,
+            this->actionCancel, &QAction::trigger
+        );
+        this->connect(
+            this->actionCancel, &QAction::changed,
+            button, [=](){
+                button->setEnabled(this->actionCancel->isEnabled());
+            }
+        );
+        toolbarLayout->addWidget(button);
+    }
     addButton("Reset", this->actionReset);
 
     addButton("Layout", this->actionLayout);
     {
         auto checkBox = new QCheckBox("Auto Layout");
-        checkBox->setCheckState( this->autoUpdateLayout ? Qt::Checked : Qt::Unchecked );
+        checkBox->setCheckState( this->layoutScheduler->isEnabled() ? Qt::Checked : Qt::Unchecked );
         this->connect(
             checkBox, &QCheckBox::stateChanged,
             this, [=](int state){
-                this->autoUpdateLayout = state;
-                this->actionAutoLayout->trigger();
+                this->layoutScheduler->setEnabled(state);
+                this->layoutScheduler->requestFullLayout();
                 return 1;
             }
         );
@@ -271,9 +414,39 @@ int NodeEditor::createToolbar(QLayout* layout){
 
     addButton("Collapse All", actionCollapseAllNodes);
 
+    {
+        auto checkBox = new QCheckBox("Profile");
+        checkBox->setCheckState( this->heatMapEnabled ? Qt::Checked : Qt::Unchecked );
+        this->connect(
+            checkBox, &QCheckBox::stateChanged,
+            this, [=](int state){
+                return this->setHeatMapEnabled(state);
+            }
+        );
+        toolbarLayout->addWidget(checkBox);
+    }
+
+    {
+        auto comboBox = new QComboBox();
+        comboBox->addItems({"Uniform Edges", "Edges by Cells", "Edges by Points", "Edges by Bytes"});
+        comboBox->setCurrentIndex( this->edgeWeightMode );
+        this->connect(
+            comboBox, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, [=](int mode){
+                return this->setEdgeWeightMode(mode);
+            }
+        );
+        toolbarLayout->addWidget(comboBox);
+    }
+
     // add spacer
     toolbarLayout->addItem( new QSpacerItem(0,0,QSizePolicy::Expanding) );
 
+    // ranking of the slowest nodes and critical path below the toolbar
+    this->profileLabel = new QLabel(this);
+    this->profileLabel->setVisible(this->heatMapEnabled);
+    layout->addWidget(this->profileLabel);
+
     return 1;
 }
 
@@ -293,15 +466,16 @@ int NodeEditor::attachServerManagerListeners(){
     this->connect(
         appCore, &pqApplicationCore::stateLoaded,
         this, [=](vtkPVXMLElement* root, vtkSMProxyLocator* locator){
-            this->actionLayout->trigger();
-            this->actionZoom->trigger();
+            this->journal->flush();
+            this->zoomAfterLayout = true;
+            this->layoutScheduler->computeFullLayout();
         }
     );
 
     // source/filter creation
     this->connect(
         smm, &pqServerManagerModel::sourceAdded,
-        this, &NodeEditor::createNodeForSource
+        this->journal, &NE::ChangeJournal::addSource
     );
 
     // source/filter deletion
@@ -313,7 +487,7 @@ int NodeEditor::attachServerManagerListeners(){
     // view creation
     this->connect(
         smm, &pqServerManagerModel::viewAdded,
-        this, &NodeEditor::createNodeForView
+        this->journal, &NE::ChangeJournal::addView
     );
 
     // view deletion
@@ -327,7 +501,7 @@ int NodeEditor::attachServerManagerListeners(){
         smm,
         static_cast<void (pqServerManagerModel::*)(pqPipelineSource*,pqPipelineSource*,int)>(&pqServerManagerModel::connectionRemoved),
         this, [=](pqPipelineSource *source, pqPipelineSource *consumer, int srcOutputPort){
-            return this->updatePipelineEdges(consumer);
+            return this->journal->rewireConsumer(consumer);
         }
     );
 
@@ -336,7 +510,7 @@ int NodeEditor::attachServerManagerListeners(){
         smm,
         static_cast<void (pqServerManagerModel::*)(pqPipelineSource*,pqPipelineSource*,int)>(&pqServerManagerModel::connectionAdded),
         this, [=](pqPipelineSource *source, pqPipelineSource *consumer, int srcOutputPort){
-            return this->updatePipelineEdges(consumer);
+            return this->journal->rewireConsumer(consumer);
         }
     );
 
@@ -346,27 +520,24 @@ int NodeEditor::attachServerManagerListeners(){
     // update proxy selections
     this->connect(
         activeObjects, &pqActiveObjects::selectionChanged,
-        this, &NodeEditor::updateActiveSourcesAndPorts
+        this->journal, &NE::ChangeJournal::changeSelection
     );
 
     // update view selection
     this->connect(
         activeObjects, &pqActiveObjects::viewChanged,
-        this, &NodeEditor::updateActiveView
+        this->journal, &NE::ChangeJournal::changeActiveView
     );
 
     // init node editor scene with exisiting views
     {
-        for(auto proxy : smm->findItems<pqPipelineSource*>()){
-            this->createNodeForSource(proxy);
-            this->updatePipelineEdges(proxy);
-        }
+        for(auto proxy : smm->findItems<pqPipelineSource*>())
+            this->journal->addSource(proxy);
 
-        for(auto proxy : smm->findItems<pqView*>()){
-            this->createNodeForView(proxy);
-            this->updateVisibilityEdges(proxy);
-            this->updateActiveView();
-        }
+        for(auto proxy : smm->findItems<pqView*>())
+            this->journal->addView(proxy);
+
+        this->journal->changeSelection();
     }
 
     return 1;
@@ -377,20 +548,22 @@ int NodeEditor::updateActiveView(){
 
     auto view = pqActiveObjects::instance().activeView();
 
-    for(auto it : this->nodeRegistry)
-        if(dynamic_cast<pqView*>(it.second->getProxy()))
-            it.second->setOutlineStyle(0);
-        else
-            it.second->getProxyProperties()->setView(view);
+    for(auto id : this->graph->getViews())
+        this->graph->getNode(id)->setOutlineStyle(0);
+
+    // hidden property widgets apply the view once they are shown
+    for(auto ids : {&this->graph->getSources(), &this->graph->getFilters()})
+        for(auto id : *ids)
+            this->graph->getNode(id)->setView(view);
 
     if(!view)
         return 1;
 
-    auto nodeIt = this->nodeRegistry.find( NE::getID(view) );
-    if(nodeIt==this->nodeRegistry.end())
+    auto node = this->graph->getNode( NE::getID(view) );
+    if(!node)
         return 1;
 
-    nodeIt->second->setOutlineStyle(2);
+    node->setOutlineStyle(2);
 
     return 1;
 }
@@ -398,44 +571,62 @@ int NodeEditor::updateActiveView(){
 int NodeEditor::updateActiveSourcesAndPorts(){
     NE::log("Selection Changed:");
 
-    // unselect all nodes
-    for(auto it : this->nodeRegistry){
-        if(!dynamic_cast<pqPipelineSource*>(it.second->getProxy()))
-            continue;
-
-        it.second->setOutlineStyle(0);
-        for(auto oPort : it.second->getOutputPorts())
-            oPort->setStyle(0);
-    }
+    // collect nodes and ports in selection
+    std::set<int> nodes;
+    std::set<std::pair<int,int>> ports;
 
-    // select nodes in selection
     const auto selection = pqActiveObjects::instance().selection();
-
     for(auto it : selection){
         if(auto source = dynamic_cast<pqPipelineSource*>(it)){
             NE::log("    -> source/filter");
 
-            auto nodeIt = this->nodeRegistry.find( NE::getID(source) );
-            if(nodeIt==this->nodeRegistry.end())
+            auto id = NE::getID(source);
+            auto node = this->graph->getNode( id );
+            if(!node)
                 continue;
 
-            nodeIt->second->setOutlineStyle(1);
-
-            auto oPorts = nodeIt->second->getOutputPorts();
-            if(oPorts.size()>0)
-                oPorts[0]->setStyle(1);
+            nodes.insert(id);
+            if(node->getOutputPorts().size()>0)
+                ports.emplace(id,0);
 
         } else if(auto port = dynamic_cast<pqOutputPort*>(it)) {
             NE::log("    -> port");
-            auto nodeIt = this->nodeRegistry.find( NE::getID(port->getSource()) );
-            if(nodeIt==this->nodeRegistry.end())
+
+            auto id = NE::getID(port->getSource());
+            if(!this->graph->getNode( id ))
                 continue;
 
-            nodeIt->second->setOutlineStyle(1);
-            nodeIt->second->getOutputPorts()[port->getPortNumber()]->setStyle(1);
+            nodes.insert(id);
+            ports.emplace(id,port->getPortNumber());
         }
     }
 
+    auto setPortStyle = [=](const std::pair<int,int>& port, int style){
+        auto node = this->graph->getNode( port.first );
+        if(!node || port.second>=(int)node->getOutputPorts().size())
+            return;
+        node->getOutputPorts()[port.second]->setStyle(style);
+    };
+
+    // only restyle nodes and ports whose state changed
+    for(auto id : this->selectedNodes)
+        if(nodes.find(id)==nodes.end())
+            if(auto node = this->graph->getNode( id ))
+                node->setOutlineStyle(0);
+    for(const auto& port : this->selectedPorts)
+        if(ports.find(port)==ports.end())
+            setPortStyle(port, 0);
+
+    for(auto id : nodes)
+        if(this->selectedNodes.find(id)==this->selectedNodes.end())
+            this->graph->getNode( id )->setOutlineStyle(1);
+    for(const auto& port : ports)
+        if(this->selectedPorts.find(port)==this->selectedPorts.end())
+            setPortStyle(port, 1);
+
+    this->selectedNodes = std::move(nodes);
+    this->selectedPorts = std::move(ports);
+
     return 1;
 }
 
@@ -459,21 +650,53 @@ NE::Node* NodeEditor::createNode(pqProxy* proxy){
         return nullptr;
     }
 
-    this->nodeRegistry.insert({ id, node });
-    this->edgeRegistry.insert({ id, std::vector<NE::Edge*>() });
+    if(proxyAsView){
+        this->graph->addNode(id, node, NE::Graph::VIEW, 1, 0);
+    } else {
+        auto proxyAsFilter = dynamic_cast<pqPipelineFilter*>(proxy);
+        this->graph->addNode(
+            id,
+            node,
+            proxyAsFilter ? NE::Graph::FILTER : NE::Graph::SOURCE,
+            proxyAsFilter ? proxyAsFilter->getNumberOfInputPorts() : 0,
+            proxyAsSource->getNumberOfOutputPorts()
+        );
+    }
+
+    node->setLevelOfDetail(this->view->getLevelOfDetail());
+
+    // the visible nodes only change with the view or with node positions
+    QObject::connect(
+        node, &NE::Node::nodeMoved,
+        this->view, &NE::View::requestVisibleNodesUpdate
+    );
+    this->view->requestVisibleNodesUpdate();
+
+    if(!proxyAsView){
+        const auto b = node->boundingRect();
+        this->scene->addLayoutNode(id, b.width(), b.height());
+    }
 
     QObject::connect(
         node, &NE::Node::nodeResized,
-        this->actionAutoLayout, &QAction::trigger
+        this->layoutScheduler, [=](){
+            if(!proxyAsView){
+                const auto b = node->boundingRect();
+                this->scene->resizeLayoutNode(id, b.width(), b.height());
+            }
+            // building a widget must not move the neighbors of its node
+            if(!node->isReplacingPlaceholder())
+                this->layoutScheduler->markResized(id);
+        }
     );
 
     auto activeProxy = pqActiveObjects::instance().activeSource();
     if(activeProxy){
-       auto prevNodeIt = this->nodeRegistry.find(
+       auto prevNode = this->graph->getNode(
            NE::getID(activeProxy)
        );
-       if(prevNodeIt!=this->nodeRegistry.end()){
-           auto prevPos = prevNodeIt->second->pos();
+       if(prevNode){
+           auto prevPos = prevNode->pos();
            node->setPos(
                prevPos.x()+350,
                prevPos.y()
@@ -481,7 +704,7 @@ NE::Node* NodeEditor::createNode(pqProxy* proxy){
        }
     }
 
-    this->actionAutoLayout->trigger();
+    this->layoutScheduler->markPlaced(id);
 
     return node;
 }
@@ -489,6 +712,16 @@ NE::Node* NodeEditor::createNode(pqProxy* proxy){
 int NodeEditor::createNodeForSource(pqPipelineSource* proxy){
     auto node = this->createNode(proxy);
 
+    // cached data information is only outdated after the pipeline executed
+    QObject::connect(
+        proxy, &pqPipelineSource::dataUpdated,
+        node, [=](pqPipelineSource* source){
+            this->dataInfoCache->invalidate(source);
+            this->requestMemoryPanelUpdate();
+            return this->updateEdgeWeights( NE::getID(source) );
+        }
+    );
+
     // update proxy selection
     {
         node->getLabel()->installEventFilter(
@@ -630,7 +863,7 @@ int NodeEditor::createNodeForView(pqView* proxy){
     QObject::connect(
         proxy, &pqView::representationVisibilityChanged,
         node, [=](pqRepresentation* rep, bool visible){
-            return this->updateVisibilityEdges(proxy);
+            return this->journal->changeVisibility(proxy);
         }
     );
 
@@ -663,51 +896,77 @@ int NodeEditor::createNodeForView(pqView* proxy){
 };
 
 int NodeEditor::removeIncomingEdges(pqProxy* proxy){
-    auto edgesIt = this->edgeRegistry.find( NE::getID(proxy) );
-    if(edgesIt!=this->edgeRegistry.end()){
-        for(int i=0; i<edgesIt->second.size(); i++)
-            if(edgesIt->second[i])
-                delete edgesIt->second[i];
-        edgesIt->second.resize(0);
+    for(auto edge : this->graph->getIncomingEdges( NE::getID(proxy) )){
+        this->graph->removeEdge(edge);
     }
     return 1;
 }
 int NodeEditor::removeNode(pqProxy* proxy){
     NE::log("Proxy Removed: "+NE::getLabel(proxy));
 
-    // remove all visibility edges
-    auto smm = pqApplicationCore::instance()->getServerManagerModel();
-    for(auto view : smm->findItems<pqView*>())
-        this->removeIncomingEdges(view);
+    // nodes are removed immediately, so drop pending changes of the proxy
+    this->journal->remove(proxy);
 
     // get id
     auto proxyId = NE::getID(proxy);
 
     // delete all incoming edges
     this->removeIncomingEdges(proxy);
-    this->edgeRegistry.erase( proxyId );
 
-    // delete all outgoing edges
-    if(auto proxyAsSource = dynamic_cast<pqPipelineSource*>(proxy))
-        for(int p=0; p<proxyAsSource->getNumberOfOutputPorts(); p++)
-            for(int i=0; i<proxyAsSource->getNumberOfConsumers(p); i++)
-                this->removeIncomingEdges(proxyAsSource->getConsumer(p,i));
+    // delete all outgoing pipeline and visibility edges
+    std::unordered_set<int> consumerIds;
+    for(auto edge : this->graph->getOutgoingEdges(proxyId)){
+        if(edge->getType()==0)
+            consumerIds.insert( NE::getID(edge->getConsumer()->getProxy()) );
+        this->graph->removeEdge(edge);
+    }
+    for(auto consumerId : consumerIds){
+        this->scene->setLayoutEdges( consumerId, this->graph->getProducers(consumerId) );
+        this->layoutScheduler->markPlaced( consumerId );
+    }
 
     // delete node
-    auto nodeIt = this->nodeRegistry.find( proxyId );
-    if(nodeIt!=this->nodeRegistry.end())
-        delete nodeIt->second;
-    this->nodeRegistry.erase( proxyId );
+    this->flaggedNodes.erase( proxyId );
+    this->requestMemoryPanelUpdate();
+    this->selectedNodes.erase( proxyId );
+    this->selectedPorts.erase(
+        this->selectedPorts.lower_bound( {proxyId, 0} ),
+        this->selectedPorts.lower_bound( {proxyId+1, 0} )
+    );
+    if(auto node = this->graph->getNode( proxyId ))
+        delete node;
+    this->graph->removeNode( proxyId );
+    this->scene->removeLayoutNode( proxyId );
+    this->layoutScheduler->markRemoved( proxyId );
 
-    // update visibility edges
-    for(auto view : smm->findItems<pqView*>())
-        this->updateVisibilityEdges(view);
+    if(this->profile.remove( proxyId ))
+        this->updateCriticalPath();
 
     this->actionAutoLayout->trigger();
 
     return 1;
 };
 
+int NodeEditor::applyChanges(const NE::ChangeJournal::Changes& changes){
+    // create all nodes first, so that edges can refer to them
+    for(auto it : changes.addedSources)
+        this->createNodeForSource(it.second);
+    for(auto it : changes.addedViews)
+        this->createNodeForView(it.second);
+
+    for(auto it : changes.rewiredConsumers)
+        this->updatePipelineEdges(it.second);
+    for(auto it : changes.changedViews)
+        this->updateVisibilityEdges(it.second);
+
+    if(changes.activeViewChanged)
+        this->updateActiveView();
+    if(changes.selectionChanged)
+        this->updateActiveSourcesAndPorts();
+
+    return 1;
+}
+
 int NodeEditor::setInput(pqPipelineSource *consumer, int idx, bool clear){
     if(clear)
       NE::log("Clear Input: "+NE::getLabel(consumer)+"["+std::to_string(idx)+"]");
@@ -794,11 +1053,11 @@ int NodeEditor::hideAllInActiveView(){
     auto viewSMProxy = static_cast<vtkSMViewProxy*>(view->getProxy());
     vtkNew<vtkSMParaViewPipelineControllerWithRendering> controller;
 
-    for(auto nodeIt : this->nodeRegistry){
-        auto proxy = dynamic_cast<vtkSMSourceProxy*>(
-            nodeIt.second->getProxy()->getProxy()
-        );
-        if(proxy)
+    for(auto ids : {&this->graph->getSources(), &this->graph->getFilters()}){
+        for(auto id : *ids){
+            auto proxy = static_cast<vtkSMSourceProxy*>(
+                this->graph->getNode(id)->getProxy()->getProxy()
+            );
             for(size_t jdx=0; jdx<proxy->GetNumberOfOutputPorts(); jdx++)
                 controller->SetVisibility(
                     proxy,
@@ -806,6 +1065,7 @@ int NodeEditor::hideAllInActiveView(){
                     viewSMProxy,
                     false
                 );
+        }
     }
 
     view->render();
@@ -814,21 +1074,72 @@ int NodeEditor::hideAllInActiveView(){
 };
 
 int NodeEditor::collapseAllNodes(){
-    for(auto nodeIt : this->nodeRegistry)
+    for(auto nodeIt : this->graph->getNodes())
         nodeIt.second->setVerbosity(0);
 
     return 1;
 };
 
+int NodeEditor::reconcileIncomingEdges(
+    int consumerId,
+    int type,
+    const std::vector<NE::Graph::EdgeKey>& desiredEdges
+){
+    auto consumerNode = this->graph->getNode( consumerId );
+    if(!consumerNode)
+        return 0;
+
+    // count desired edges, since a port may be connected more than once
+    std::map<NE::Graph::EdgeKey,int> missingEdges;
+    for(const auto& key : desiredEdges)
+        missingEdges[key]++;
+
+    // keep existing edges that are still desired
+    int nChanges = 0;
+    for(auto edge : this->graph->getIncomingEdges( consumerId )){
+        if(edge->getType()!=type)
+            continue;
+
+        auto it = missingEdges.find( NE::Graph::getKey(edge) );
+        if(it!=missingEdges.end() && it->second>0){
+            it->second--;
+            continue;
+        }
+
+        this->graph->removeEdge(edge);
+        nChanges++;
+    }
+
+    // create missing edges
+    for(const auto& it : missingEdges){
+        auto producerNode = this->graph->getNode( std::get<0>(it.first) );
+        if(!producerNode)
+            continue;
+
+        for(int i=0; i<it.second; i++){
+            auto edge = this->graph->addEdge(
+                producerNode,
+                std::get<1>(it.first),
+                consumerNode,
+                std::get<3>(it.first),
+                type
+            );
+            if(edge)
+                this->updateEdgeWeight(edge);
+            nChanges++;
+        }
+    }
+
+    return nChanges;
+}
+
 int NodeEditor::updateVisibilityEdges(pqView* proxy){
     NE::log("Updating Visibility Pipeline Edges: "+NE::getLabel(proxy));
 
-    this->removeIncomingEdges(proxy);
-
-    auto viewEdgesIt = this->edgeRegistry.find( NE::getID(proxy) );
-    if(viewEdgesIt==this->edgeRegistry.end())
-        return 1;
+    const int viewId = NE::getID(proxy);
 
+    // collect the producers of all visible representations
+    std::vector<NE::Graph::EdgeKey> desiredEdges;
     for(int i=0; i<proxy->getNumberOfRepresentations(); i++){
         auto rep = proxy->getRepresentation(i);
         if(!rep)
@@ -839,28 +1150,17 @@ int NodeEditor::updateVisibilityEdges(pqView* proxy){
             continue;
 
         auto producerPort = repAsDataRep->getOutputPortFromInput();
-        auto producerIt = this->nodeRegistry.find( NE::getID(producerPort->getSource()) );
-        if(producerIt==this->nodeRegistry.end())
-            continue;
-
-        auto viewIt = this->nodeRegistry.find( NE::getID(proxy) );
-        if(viewIt==this->nodeRegistry.end())
-            continue;
-
-        // create edge
-        viewEdgesIt->second.push_back(
-            new NE::Edge(
-                this->scene,
-                producerIt->second,
-                producerPort->getPortNumber(),
-                viewIt->second,
-                0,
-                1
-            )
+        desiredEdges.emplace_back(
+            NE::getID(producerPort->getSource()),
+            producerPort->getPortNumber(),
+            viewId,
+            0,
+            1
         );
     }
 
-    this->actionAutoLayout->trigger();
+    if(this->reconcileIncomingEdges(viewId, 1, desiredEdges)>0)
+        this->layoutScheduler->markPlaced( viewId );
 
     return 1;
 }
@@ -874,56 +1174,509 @@ int NodeEditor::updatePipelineEdges(pqPipelineSource *consumer){
         return 1;
     }
 
-    // get node of consumer
-    auto consumerIt = this->nodeRegistry.find( NE::getID(consumer) );
-    if(consumerIt==this->nodeRegistry.end()){
-        return 1;
-    }
-
-    // remove all input edges
-    this->removeIncomingEdges(consumer);
-
-    auto consumerEdgesIt = this->edgeRegistry.find( NE::getID(consumer) );
-    if(consumerEdgesIt==this->edgeRegistry.end()){
-        return 1;
-    }
+    const int consumerId = NE::getID(consumer);
 
-    // recreate all incoming edges
+    // collect the output ports connected to all input ports
+    std::vector<NE::Graph::EdgeKey> desiredEdges;
+    std::vector<int> producerIds;
     for(int iPortIdx=0; iPortIdx<consumerAsFilter->getNumberOfInputPorts(); iPortIdx++){
 
         // retrieve current input port name
         auto iPortName = consumerAsFilter->getInputPortName(iPortIdx);
 
-        // get number of all outconsumerNodeput ports connected to current input port
+        // get number of all output ports connected to current input port
         int numberOfOutputPortsAtInputPort = consumerAsFilter->getNumberOfInputs( iPortName );
         for(int oPortIt=0; oPortIt<numberOfOutputPortsAtInputPort; oPortIt++){
             // get current output port connected to current input port
             auto producerPort = consumerAsFilter->getInput( iPortName, oPortIt );
 
             // get source of current output port
-            auto producer = producerPort->getSource();
-
-            // get node of producer
-            auto producerIt = this->nodeRegistry.find( NE::getID(producer) );
-            if(producerIt==this->nodeRegistry.end()){
+            const int producerId = NE::getID( producerPort->getSource() );
+            if(!this->graph->getNode( producerId ))
                 continue;
-            }
 
-            // create edge
-            consumerEdgesIt->second.push_back(
-                new NE::Edge(
-                    this->scene,
-                    producerIt->second,
-                    producerPort->getPortNumber(),
-                    consumerIt->second,
-                    iPortIdx
-                )
+            desiredEdges.emplace_back(
+                producerId,
+                producerPort->getPortNumber(),
+                consumerId,
+                iPortIdx,
+                0
             );
+            producerIds.push_back( producerId );
         }
     }
 
-    this->actionAutoLayout->trigger();
+    if(this->reconcileIncomingEdges(consumerId, 0, desiredEdges)<1)
+        return 1;
+
+    this->scene->setLayoutEdges( consumerId, producerIds );
+    this->layoutScheduler->markPlaced( consumerId );
 
     return 1;
 };
 
+int NodeEditor::recordExecution(int id, double duration){
+    auto node = this->graph->getNode(id);
+    if(!node)
+        return 0;
+
+    // the memory size is only requested while the overlay is shown and
+    // arrives through the data information cache
+    auto sample = this->profile.get(id);
+    const double memory = this->heatMapEnabled
+        ? this->getOutputMemory(id)
+        : sample ? sample->memory : 0;
+
+    const double maxTime = this->profile.getMaxTime();
+    this->profile.record(id, duration, memory);
+
+    // heats are relative to the slowest node, so all nodes change with it
+    return this->updateHeatMap( this->profile.getMaxTime()==maxTime ? id : -1 );
+}
+
+int NodeEditor::updateProfileMemory(int id){
+    auto sample = this->profile.get(id);
+    if(!this->heatMapEnabled || !sample)
+        return 0;
+
+    this->profile.updateMemory(id, this->getOutputMemory(id));
+    return this->updateHeatMap(id);
+}
+
+int NodeEditor::updateHeatMap(int id){
+    if(!this->heatMapEnabled)
+        return 0;
+
+    auto updateNode = [=](int nodeId, NE::Node* node){
+        auto sample = this->profile.get(nodeId);
+        if(!sample)
+            return node->setHeat(-1);
+
+        auto annotation = NE::Profile::formatTime(sample->time)
+            + " | "
+            + NE::Profile::formatMemory(sample->memory);
+        auto share = this->criticalShares.find(nodeId);
+        if(share!=this->criticalShares.end())
+            annotation += " | " + std::to_string((int)std::round(100*share->second)) + "%";
+
+        const double maxTime = this->profile.getMaxTime();
+        return node->setHeat(
+            maxTime>0 ? sample->time/maxTime : 0,
+            QString::fromStdString(annotation)
+        );
+    };
+
+    if(id<0){
+        for(auto it : this->graph->getNodes())
+            updateNode(it.first, it.second);
+    } else if(auto node = this->graph->getNode(id)) {
+        updateNode(id, node);
+    }
+
+    // unmodified nodes keep the times of earlier Applies
+    std::string ranking = "Slowest (last known times):";
+    int rank = 1;
+    for(auto topId : this->profile.getTopOffenders(NE::CONSTS::PROFILE_TOP_COUNT)){
+        auto node = this->graph->getNode(topId);
+        auto sample = this->profile.get(topId);
+        if(!node || !sample)
+            continue;
+        ranking += "  " + std::to_string(rank++) + ". "
+            + NE::getLabel(node->getProxy()) + " "
+            + NE::Profile::formatTime(sample->time) + " / "
+            + NE::Profile::formatMemory(sample->memory);
+    }
+
+    // share of each node on the critical path in the end-to-end latency
+    if(!this->criticalNodes.empty()){
+        ranking += "\nCritical path of last Apply " + NE::Profile::formatTime(this->criticalLength) + ":";
+        for(size_t i=0; i<this->criticalNodes.size(); i++){
+            auto node = this->graph->getNode(this->criticalNodes[i]);
+            if(!node)
+                continue;
+            ranking += (i>0 ? "  > " : "  ")
+                + NE::getLabel(node->getProxy()) + " "
+                + std::to_string((int)std::round(100*this->criticalShares[this->criticalNodes[i]])) + "%";
+        }
+    }
+
+    this->profileLabel->setText(QString::fromStdString(ranking));
+
+    return 1;
+}
+
+int NodeEditor::updateCriticalPath(){
+    // clear the previous path
+    for(auto id : this->criticalNodes)
+        if(auto node = this->graph->getNode(id))
+            node->setCritical(false);
+    for(auto handle : this->criticalEdges)
+        if(auto edge = this->graph->getEdge(handle))
+            edge->setHighlighted(false);
+    this->criticalNodes.clear();
+    this->criticalEdges.clear();
+    this->criticalShares.clear();
+    this->criticalLength = 0;
+
+    if(!this->heatMapEnabled)
+        return 0;
+
+    // only nodes executed together form a meaningful end-to-end latency
+    std::unordered_map<int,double> times;
+    for(const auto& it : this->profile.getSamples())
+        if(it.second.run==this->profile.getRun())
+            times[it.first] = it.second.time;
+
+    this->criticalNodes = this->graph->getCriticalPath(times, this->criticalLength);
+    for(size_t i=0; i<this->criticalNodes.size(); i++){
+        const int id = this->criticalNodes[i];
+        this->graph->getNode(id)->setCritical(true);
+        this->criticalShares[id] = this->criticalLength>0 ? times[id]/this->criticalLength : 0;
+
+        if(i<1)
+            continue;
+
+        // highlight the edge from the previous node on the path
+        for(auto edge : this->graph->getIncomingEdges(id)){
+            if(NE::getID(edge->getProducer()->getProxy())!=this->criticalNodes[i-1])
+                continue;
+            edge->setHighlighted(true);
+            this->criticalEdges.push_back(edge->getHandle());
+            break;
+        }
+    }
+
+    return this->updateHeatMap();
+}
+
+int NodeEditor::setHeatMapEnabled(bool enabled){
+    this->heatMapEnabled = enabled;
+    this->profileLabel->setVisible(enabled);
+
+    // computes or clears the critical path and updates the heat map
+    this->updateCriticalPath();
+    if(enabled){
+        // samples recorded while the overlay was hidden lack their memory
+        std::vector<int> ids;
+        for(const auto& it : this->profile.getSamples())
+            ids.push_back(it.first);
+        for(auto id : ids)
+            this->updateProfileMemory(id);
+        return 1;
+    }
+
+    for(auto it : this->graph->getNodes())
+        it.second->setHeat(-1);
+    return 1;
+}
+
+int NodeEditor::setEdgeWeightMode(int mode){
+    this->edgeWeightMode = mode;
+    for(auto it : this->graph->getNodes())
+        this->updateEdgeWeights(it.first);
+    return 1;
+}
+
+int NodeEditor::updateEdgeWeights(int producerId){
+    for(auto edge : this->graph->getOutgoingEdges(producerId))
+        this->updateEdgeWeight(edge);
+    return 1;
+}
+
+int NodeEditor::updateEdgeWeight(NE::Edge* edge){
+    if(this->edgeWeightMode<1)
+        return edge->setWeight(0);
+
+    auto source = dynamic_cast<pqPipelineSource*>(edge->getProducer()->getProxy());
+    if(!source)
+        return 0;
+    auto port = source->getOutputPort(edge->getProducerOutputPortIdx());
+    if(!port)
+        return 0;
+
+    // the weight is updated once missing information arrives
+    auto info = this->dataInfoCache->get(port);
+    if(!info)
+        return 0;
+
+    const double value = this->edgeWeightMode==1
+        ? info->cells
+        : this->edgeWeightMode==2
+            ? info->points
+            : info->bytes;
+
+    // one class per three orders of magnitude
+    return edge->setWeight( value<1 ? 1 : 1+(int)(std::log10(value)/3) );
+}
+
+QString NodeEditor::getEdgeToolTip(NE::Edge* edge){
+    auto source = dynamic_cast<pqPipelineSource*>(edge->getProducer()->getProxy());
+    auto port = source ? source->getOutputPort(edge->getProducerOutputPortIdx()) : nullptr;
+    if(!port)
+        return QString();
+
+    auto text = NE::getLabel(source) + ":" + port->getPortName().toStdString()
+        + " > " + NE::getLabel(edge->getConsumer()->getProxy());
+
+    auto info = this->dataInfoCache->get(port);
+    if(!info)
+        return QString::fromStdString(text + "\nFetching data information...");
+
+    return QString::fromStdString(
+        text + "\n"
+        + std::to_string((long long)info->cells) + " cells, "
+        + std::to_string((long long)info->points) + " points, "
+        + NE::Profile::formatMemory(info->bytes)
+    );
+}
+
+int NodeEditor::createMemoryPanel(QLayout* layout){
+    auto toggle = new QCheckBox("Memory Budget");
+    this->memoryPanel = new QWidget(this);
+    this->memoryPanel->hide();
+
+    auto panelLayout = new QVBoxLayout;
+    panelLayout->setContentsMargins(0,0,0,0);
+    this->memoryPanel->setLayout(panelLayout);
+
+    // threshold and actions
+    {
+        auto row = new QWidget;
+        auto rowLayout = new QHBoxLayout;
+        rowLayout->setContentsMargins(0,0,0,0);
+        row->setLayout(rowLayout);
+
+        auto threshold = new QSpinBox;
+        threshold->setRange(1, 1024*1024);
+        threshold->setSuffix(" MiB");
+        threshold->setValue(this->memoryThreshold);
+        this->connect(
+            threshold, QOverload<int>::of(&QSpinBox::valueChanged),
+            this, [=](int value){
+                this->memoryThreshold = value;
+                return this->requestMemoryPanelUpdate();
+            }
+        );
+        rowLayout->addWidget(new QLabel("Threshold"));
+        rowLayout->addWidget(threshold);
+
+        auto releaseSelected = new QPushButton("Release Selected");
+        this->connect(
+            releaseSelected, &QPushButton::released,
+            this, &NodeEditor::releaseSelectedOutputs
+        );
+        rowLayout->addWidget(releaseSelected);
+
+        auto releaseInvisible = new QPushButton("Release Invisible Branches");
+        this->connect(
+            releaseInvisible, &QPushButton::released,
+            this, &NodeEditor::releaseInvisibleBranches
+        );
+        rowLayout->addWidget(releaseInvisible);
+
+        rowLayout->addItem( new QSpacerItem(0,0,QSizePolicy::Expanding) );
+        panelLayout->addWidget(row);
+    }
+
+    this->memoryLabel = new QLabel;
+    panelLayout->addWidget(this->memoryLabel);
+
+    // the panel is rebuilt at most once per event loop pass
+    this->memoryPanelTimer = new QTimer(this);
+    this->memoryPanelTimer->setSingleShot(true);
+    this->memoryPanelTimer->setInterval(0);
+    QObject::connect(
+        this->memoryPanelTimer, &QTimer::timeout,
+        this, &NodeEditor::updateMemoryPanel
+    );
+
+    this->connect(
+        toggle, &QCheckBox::stateChanged,
+        this, [=](int state){
+            this->memoryPanel->setVisible(state);
+            if(state)
+                return this->requestMemoryPanelUpdate();
+
+            for(auto id : this->flaggedNodes)
+                if(auto node = this->graph->getNode(id))
+                    node->setMemoryFlag(false);
+            this->flaggedNodes.clear();
+            return 1;
+        }
+    );
+
+    layout->addWidget(toggle);
+    layout->addWidget(this->memoryPanel);
+
+    return 1;
+}
+
+int NodeEditor::requestMemoryPanelUpdate(){
+    if(this->memoryPanel->isHidden() || this->memoryPanelTimer->isActive())
+        return 0;
+    this->memoryPanelTimer->start();
+    return 1;
+}
+
+double NodeEditor::getOutputMemory(int id){
+    auto node = this->graph->getNode(id);
+    auto source = node ? dynamic_cast<pqPipelineSource*>(node->getProxy()) : nullptr;
+    if(!source)
+        return 0;
+
+    // missing information is requested and updates the panel once available
+    double bytes = 0;
+    for(auto port : source->getOutputPorts())
+        if(auto info = this->dataInfoCache->get(port))
+            bytes += info->bytes;
+    return bytes;
+}
+
+int NodeEditor::updateMemoryPanel(){
+    if(this->memoryPanel->isHidden())
+        return 0;
+
+    // output sizes of all sources and filters
+    std::vector<int> ids(this->graph->getSources().begin(), this->graph->getSources().end());
+    ids.insert(ids.end(), this->graph->getFilters().begin(), this->graph->getFilters().end());
+
+    std::unordered_map<int,double> sizes;
+    double total = 0;
+    for(auto id : ids){
+        sizes[id] = this->getOutputMemory(id);
+        total += sizes[id];
+    }
+
+    // flag nodes above the threshold
+    const double threshold = 1024.0*1024.0*this->memoryThreshold;
+    std::set<int> flagged;
+    for(const auto& it : sizes)
+        if(it.second>threshold)
+            flagged.insert(it.first);
+    for(auto id : this->flaggedNodes)
+        if(!flagged.count(id))
+            if(auto node = this->graph->getNode(id))
+                node->setMemoryFlag(false);
+    for(auto id : flagged)
+        this->graph->getNode(id)->setMemoryFlag(true);
+    this->flaggedNodes = std::move(flagged);
+
+    // a branch is a source, the consumer of a fork or a merge with everything
+    // downstream up to the next fork or merge, so every node belongs to
+    // exactly one branch and all totals are accumulated in one reverse
+    // topological pass
+    std::vector<std::pair<double,int>> branches;
+    std::unordered_map<int,double> branchSizes;
+    const auto order = this->graph->getDownstream(ids);
+    for(auto it=order.rbegin(); it!=order.rend(); ++it){
+        const int id = *it;
+        branchSizes[id] += sizes[id];
+
+        const auto producers = this->graph->getProducers(id);
+        const std::set<int> producerIds(producers.begin(), producers.end());
+        bool isRoot = producerIds.size()!=1;
+        if(!isRoot){
+            std::set<int> consumers;
+            for(auto edge : this->graph->getOutgoingEdges(*producerIds.begin()))
+                if(edge->getType()==0)
+                    consumers.insert( NE::getID(edge->getConsumer()->getProxy()) );
+            isRoot = consumers.size()>1;
+        }
+
+        if(isRoot)
+            branches.emplace_back(branchSizes[id], id);
+        else
+            branchSizes[*producerIds.begin()] += branchSizes[id];
+    }
+
+    auto describe = [=](std::vector<std::pair<double,int>>& entries){
+        const size_t n = std::min<size_t>(NE::CONSTS::PROFILE_TOP_COUNT, entries.size());
+        std::partial_sort(entries.begin(), entries.begin()+n, entries.end(), std::greater<std::pair<double,int>>());
+        std::string text;
+        for(size_t i=0; i<n; i++)
+            text += "  " + NE::getLabel(this->graph->getNode(entries[i].second)->getProxy())
+                + " " + NE::Profile::formatMemory(entries[i].first);
+        return text;
+    };
+
+    std::vector<std::pair<double,int>> nodes;
+    for(const auto& it : sizes)
+        nodes.emplace_back(it.second, it.first);
+
+    this->memoryLabel->setText(QString::fromStdString(
+        "Resident outputs: " + NE::Profile::formatMemory(total)
+        + " in " + std::to_string(ids.size()) + " nodes, "
+        + std::to_string(this->flaggedNodes.size()) + " above threshold"
+        + "\nLargest nodes:" + describe(nodes)
+        + "\nLargest branches:" + describe(branches)
+    ));
+
+    return 1;
+}
+
+int NodeEditor::releaseOutputs(int id){
+    auto node = this->graph->getNode(id);
+    auto source = node ? dynamic_cast<pqPipelineSource*>(node->getProxy()) : nullptr;
+    if(!source)
+        return 0;
+
+    NE::log("Release Outputs: "+NE::getLabel(source));
+
+    // release the output data objects where they live; released data is
+    // regenerated by the next update of the pipeline
+    auto smProxy = static_cast<vtkSMSourceProxy*>(source->getProxy());
+    vtkClientServerStream stream;
+    for(int i=0; i<source->getNumberOfOutputPorts(); i++){
+        stream << vtkClientServerStream::Invoke
+            << VTKOBJECT(smProxy) << "GetOutputDataObject" << i
+            << vtkClientServerStream::End;
+        stream << vtkClientServerStream::Invoke
+            << vtkClientServerStream::LastResult << "ReleaseData"
+            << vtkClientServerStream::End;
+    }
+    smProxy->GetSession()->ExecuteStream(smProxy->GetLocation(), stream, false);
+
+    for(unsigned int i=0; i<smProxy->GetNumberOfOutputPorts(); i++)
+        smProxy->GetOutputPort(i)->InvalidateDataInformation();
+    this->dataInfoCache->invalidate(source);
+
+    return 1;
+}
+
+int NodeEditor::releaseSelectedOutputs(){
+    std::set<int> ids;
+    for(auto it : pqActiveObjects::instance().selection()){
+        if(auto source = dynamic_cast<pqPipelineSource*>(it))
+            ids.insert( NE::getID(source) );
+        else if(auto port = dynamic_cast<pqOutputPort*>(it))
+            ids.insert( NE::getID(port->getSource()) );
+    }
+
+    for(auto id : ids)
+        this->releaseOutputs(id);
+
+    return this->requestMemoryPanelUpdate();
+}
+
+int NodeEditor::releaseInvisibleBranches(){
+    std::vector<int> ids(this->graph->getSources().begin(), this->graph->getSources().end());
+    ids.insert(ids.end(), this->graph->getFilters().begin(), this->graph->getFilters().end());
+    const auto order = this->graph->getDownstream(ids);
+
+    // consumers come first in reverse order, so visibility propagates upstream
+    std::unordered_set<int> visible;
+    for(auto it=order.rbegin(); it!=order.rend(); ++it){
+        for(auto edge : this->graph->getOutgoingEdges(*it)){
+            if(edge->getType()==1 || visible.count( NE::getID(edge->getConsumer()->getProxy()) )){
+                visible.insert(*it);
+                break;
+            }
+        }
+    }
+
+    for(auto id : order)
+        if(!visible.count(id))
+            this->releaseOutputs(id);
+
+    return this->requestMemoryPanelUpdate();
+}
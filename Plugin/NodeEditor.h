@@ -1,14 +1,22 @@
 #pragma once
 
+// node editor includes
+#include <ChangeJournal.h>
+#include <Graph.h>
+#include <Profile.h>
+
 // qt includes
 #include <QDockWidget>
 
 // std includes
-#include <unordered_map>
+#include <set>
+#include <utility>
 
 // forward declarations
 class QAction;
+class QLabel;
 class QLayout;
+class QTimer;
 
 class pqProxy;
 class pqPipelineSource;
@@ -21,6 +29,9 @@ namespace NE {
     class Edge;
     class Scene;
     class View;
+    class LayoutScheduler;
+    class ApplyQueue;
+    class DataInfoCache;
 }
 
 /// This is the root widget of the node editor that can be docked in ParaView.
@@ -41,6 +52,26 @@ class NodeEditor : public QDockWidget {
         int createToolbar(QLayout* layout);
         int attachServerManagerListeners();
 
+        /// Creates the memory budget panel below the toolbar.
+        int createMemoryPanel(QLayout* layout);
+
+        /// Returns the cached memory size of all outputs of a node in bytes.
+        double getOutputMemory(int id);
+
+        /// Shows a new source without consumers in the active view and
+        /// hides its inputs.
+        int showActiveSource();
+
+        /// Reconciles the incoming edges of a type of a node with the
+        /// desired set of edges. Only edges that are not part of the desired
+        /// set are destroyed, and only missing edges are created. Returns
+        /// the number of created and destroyed edges.
+        int reconcileIncomingEdges(
+            int consumerId,
+            int type,
+            const std::vector<NE::Graph::EdgeKey>& desiredEdges
+        );
+
     public slots:
         int apply();
         int reset();
@@ -51,6 +82,10 @@ class NodeEditor : public QDockWidget {
         int createNodeForView(pqView* proxy);
         int removeNode(pqProxy* proxy);
 
+        /// Applies the net changes of one event loop pass: creates nodes,
+        /// rebuilds edges and refreshes the selection.
+        int applyChanges(const NE::ChangeJournal::Changes& changes);
+
         int setInput(pqPipelineSource *consumer, int idx, bool clear);
 
         int updateActiveView();
@@ -65,23 +100,89 @@ class NodeEditor : public QDockWidget {
 
         int collapseAllNodes();
 
+        /// Records the execution time of a node, and the cached memory size
+        /// of its outputs while the overlay is shown, and updates the heat map.
+        int recordExecution(int id, double duration);
+
+        /// Updates the recorded memory size of a node from the data
+        /// information cache while the overlay is shown.
+        int updateProfileMemory(int id);
+
+        /// Updates the heat of a node, or of all nodes if the id is
+        /// negative, and the ranking of the slowest nodes.
+        int updateHeatMap(int id=-1);
+        int setHeatMapEnabled(bool enabled);
+
+        /// Computes the chain of nodes with the largest sum of execution
+        /// times of the last Apply from a source to a view, highlights its
+        /// nodes and edges, and reports the share of each node in the total
+        /// latency.
+        int updateCriticalPath();
+
+        /// Sets the data volume encoded by edge widths (0: none, 1: cells,
+        /// 2: points, 3: bytes) and updates all edges.
+        int setEdgeWeightMode(int mode);
+
+        /// Updates the widths of all outgoing edges of a node.
+        int updateEdgeWeights(int producerId);
+        int updateEdgeWeight(NE::Edge* edge);
+
+        QString getEdgeToolTip(NE::Edge* edge);
+
+        /// Totals the output sizes per node and per branch and flags nodes
+        /// above the memory threshold. Branches end at forks and merges, so
+        /// every node is counted in exactly one branch.
+        int updateMemoryPanel();
+        int requestMemoryPanelUpdate();
+
+        /// Releases the output data of a source or filter without deleting
+        /// its proxy. The outputs are regenerated by the next update.
+        int releaseOutputs(int id);
+        int releaseSelectedOutputs();
+
+        /// Releases the outputs of all nodes whose branch feeds no visible
+        /// representation.
+        int releaseInvisibleBranches();
+
     private:
         NE::Scene* scene;
         NE::View* view;
+        NE::LayoutScheduler* layoutScheduler;
+        NE::ChangeJournal* journal;
+        NE::ApplyQueue* applyQueue;
+        NE::Profile profile;
+        NE::DataInfoCache* dataInfoCache;
+        int edgeWeightMode{0}; // 0: uniform, 1: cells, 2: points, 3: bytes
+
+        QWidget* memoryPanel;
+        QLabel* memoryLabel;
+        QTimer* memoryPanelTimer;
+        std::set<int> flaggedNodes;
+        int memoryThreshold; // MiB, defaults to NE::CONSTS::MEMORY_THRESHOLD
+        bool heatMapEnabled{false};
+
+        std::vector<int> criticalNodes;
+        std::vector<NE::EdgeHandle> criticalEdges;
+        std::unordered_map<int,double> criticalShares;
+        double criticalLength{0};
+        QLabel* profileLabel;
+        bool zoomAfterLayout{false};
 
-        bool autoUpdateLayout{true};
         QAction* actionZoom;
         QAction* actionLayout;
         QAction* actionApply;
+        QAction* actionCancel;
         QAction* actionReset;
         QAction* actionAutoLayout;
         QAction* actionCollapseAllNodes;
 
-        /// The node registry stores a node for each source/filter/view proxy
-        /// The key is the global identifier of the node proxy.
-        std::unordered_map<int,NE::Node*> nodeRegistry;
+        /// The graph stores a node for each source/filter/view proxy and
+        /// the edges between their ports. The key of a node is the global
+        /// identifier of the node proxy.
+        NE::Graph* graph;
 
-        /// The edge registry stores all incoming edges of a node.
-        /// The key is the global identifier of the node proxy.
-        std::unordered_map<int,std::vector<NE::Edge*>> edgeRegistry;
+        /// The currently highlighted nodes and (node id, output port)
+        /// pairs, so that a selection change only restyles the difference.
+        std::set<int> selectedNodes;
+        std::set<std::pair<int,int>> selectedPorts;
 };
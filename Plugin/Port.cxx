@@ -39,12 +39,6 @@ NE::Port::Port(
     : QGraphicsItem(parent)
 {
     this->label = new PortLabel(name, this);
-    this->label->setPos(
-        type==0
-            ? this->portRadius+3
-            : -this->portRadius-3 - this->label->boundingRect().width(),
-        -0.5*this->label->boundingRect().height()
-    );
 
     this->disc = new QGraphicsEllipseItem(
         -this->portRadius,
@@ -54,12 +48,30 @@ NE::Port::Port(
         this
     );
     this->disc->setBrush( QApplication::palette().dark() );
-    this->setStyle( 0 );
+    this->reset( type, name );
 }
 
 NE::Port::~Port(){
 }
 
+int NE::Port::reset(int type, QString name){
+    auto font = this->label->font();
+    font.setBold(false);
+    this->label->setFont(font);
+    this->label->setPlainText(name);
+    this->label->setVisible(true);
+    this->label->setPos(
+        type==0
+            ? this->portRadius+3
+            : -this->portRadius-3 - this->label->boundingRect().width(),
+        -0.5*this->label->boundingRect().height()
+    );
+
+    this->setPos(0,0);
+    this->setStyle( 0 );
+    return 1;
+}
+
 int NE::Port::setStyle(int style){
     this->disc->setPen(
         QPen(
@@ -72,6 +84,50 @@ int NE::Port::setStyle(int style){
     return 1;
 }
 
+int NE::Port::setLevelOfDetail(int level){
+    this->label->setVisible(level<2);
+    return 1;
+}
+
+NE::PortPool::PortPool(){
+}
+
+NE::PortPool::~PortPool(){
+    for(auto port : this->ports)
+        delete port;
+}
+
+NE::Port* NE::PortPool::acquire(
+    int type,
+    QString name,
+    QGraphicsItem* parent
+){
+    if(this->ports.empty())
+        return new NE::Port(type, name, parent);
+
+    auto port = this->ports.back();
+    this->ports.pop_back();
+    port->reset( type, name );
+    port->setParentItem( parent );
+    return port;
+}
+
+int NE::PortPool::release(NE::Port* port){
+    NE::removeInterceptors( port->label );
+
+    port->setParentItem( nullptr );
+    if(port->scene())
+        port->scene()->removeItem( port );
+
+    if(this->ports.size()>=(size_t)NE::CONSTS::PORT_POOL_SIZE){
+        delete port;
+        return 0;
+    }
+
+    this->ports.push_back( port );
+    return 1;
+}
+
 QRectF NE::Port::boundingRect() const {
     return QRectF(0,0,0,0);
 }
@@ -3,6 +3,9 @@
 // QT includes
 #include <QGraphicsItem>
 
+// std includes
+#include <vector>
+
 class QGraphicsEllipseItem;
 class QGraphicsTextItem;
 
@@ -29,15 +32,47 @@ namespace NE {
 
             int setStyle(int style);
 
+            /// Hides the port label at minimal level of detail.
+            int setLevelOfDetail(int level);
+
         protected:
             QRectF boundingRect() const override;
             void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override;
 
         private:
+            friend class PortPool;
+
+            /// Sets the label text and moves it to the side of its type.
+            int reset(int type, QString name);
+
             QGraphicsEllipseItem* disc;
             QGraphicsTextItem* label;
 
             int borderWidth{4};
             int portRadius{8};
     };
+
+    /// This class keeps the ports of deleted nodes of a scene, so that later
+    /// nodes reuse them instead of creating new items. The pool holds at most
+    /// NE::CONSTS::PORT_POOL_SIZE ports and deletes them on destruction.
+    class PortPool {
+
+        public:
+            PortPool();
+            ~PortPool();
+
+            /// Returns a released port or creates a new one if none is left.
+            NE::Port* acquire(
+                int type,
+                QString name = "",
+                QGraphicsItem* parent=nullptr
+            );
+
+            /// Detaches a port from its node and keeps it for later nodes.
+            /// Interceptors installed on the label are removed.
+            int release(NE::Port* port);
+
+        private:
+            std::vector<NE::Port*> ports;
+    };
 }
\ No newline at end of file
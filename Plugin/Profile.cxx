@@ -0,0 +1,109 @@
+#include <Profile.h>
+
+// std includes
+#include <algorithm>
+#include <cstdio>
+
+NE::Profile::Profile(){
+}
+
+NE::Profile::~Profile(){
+}
+
+int NE::Profile::startRun(){
+    this->run++;
+    return 1;
+}
+
+int NE::Profile::record(int id, double time, double memory){
+    auto& sample = this->samples[id];
+    const bool wasMaximum = sample.time>=this->maxTime || sample.memory>=this->maxMemory;
+
+    sample.time = time;
+    sample.memory = memory;
+    sample.run = this->run;
+
+    // the maxima only have to be searched again if a maximum shrinks
+    if(wasMaximum)
+        return this->updateMaxima();
+
+    this->maxTime = std::max(this->maxTime, time);
+    this->maxMemory = std::max(this->maxMemory, memory);
+    return 1;
+}
+
+int NE::Profile::updateMemory(int id, double memory){
+    auto it = this->samples.find(id);
+    if(it==this->samples.end())
+        return 0;
+
+    const bool wasMaximum = it->second.memory>=this->maxMemory;
+    it->second.memory = memory;
+    if(wasMaximum)
+        return this->updateMaxima();
+
+    this->maxMemory = std::max(this->maxMemory, memory);
+    return 1;
+}
+
+int NE::Profile::remove(int id){
+    if(this->samples.erase(id)<1)
+        return 0;
+    return this->updateMaxima();
+}
+
+const NE::Profile::Sample* NE::Profile::get(int id) const {
+    auto it = this->samples.find(id);
+    return it==this->samples.end() ? nullptr : &it->second;
+}
+
+std::vector<int> NE::Profile::getTopOffenders(size_t n) const {
+    std::vector<std::pair<double,int>> ranking;
+    ranking.reserve(this->samples.size());
+    for(const auto& it : this->samples)
+        ranking.emplace_back(it.second.time, it.first);
+
+    n = std::min(n, ranking.size());
+    std::partial_sort(
+        ranking.begin(), ranking.begin()+n, ranking.end(),
+        [](const std::pair<double,int>& a, const std::pair<double,int>& b){
+            return a.first>b.first || (a.first==b.first && a.second<b.second);
+        }
+    );
+
+    std::vector<int> ids;
+    for(size_t i=0; i<n; i++)
+        ids.push_back(ranking[i].second);
+    return ids;
+}
+
+std::string NE::Profile::formatTime(double seconds){
+    char buffer[32];
+    if(seconds<1)
+        std::snprintf(buffer, sizeof(buffer), "%.0f ms", seconds*1000);
+    else
+        std::snprintf(buffer, sizeof(buffer), "%.2f s", seconds);
+    return buffer;
+}
+
+std::string NE::Profile::formatMemory(double bytes){
+    const char* units[] = {"B", "KiB", "MiB", "GiB", "TiB"};
+    int unit = 0;
+    while(bytes>=1024 && unit<4){
+        bytes /= 1024;
+        unit++;
+    }
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), unit==0 ? "%.0f %s" : "%.1f %s", bytes, units[unit]);
+    return buffer;
+}
+
+int NE::Profile::updateMaxima(){
+    this->maxTime = 0;
+    this->maxMemory = 0;
+    for(const auto& it : this->samples){
+        this->maxTime = std::max(this->maxTime, it.second.time);
+        this->maxMemory = std::max(this->maxMemory, it.second.memory);
+    }
+    return 1;
+}
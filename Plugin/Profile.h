@@ -0,0 +1,67 @@
+#pragma once
+
+// std includes
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace NE {
+
+    /// This class records the wall time of the last execution of every node
+    /// and the memory size of its outputs. Samples are recorded by Apply one
+    /// node at a time and are kept until the node is executed again or
+    /// removed. Every sample stores the run, i.e., the Apply, it was recorded
+    /// in, since an Apply only executes the modified part of the pipeline.
+    class Profile {
+
+        public:
+            struct Sample {
+                double time{0};   // seconds
+                double memory{0}; // bytes
+                unsigned int run{0};
+            };
+
+            Profile();
+            ~Profile();
+
+            /// Starts a new run. Subsequent samples are recorded in it.
+            int startRun();
+
+            unsigned int getRun() const {return this->run;};
+
+            /// Records the last execution of a node in the current run.
+            int record(int id, double time, double memory);
+
+            /// Updates the memory size of a recorded node without changing
+            /// its run. Returns 0 if there is no sample.
+            int updateMemory(int id, double memory);
+
+            /// Drops the sample of a node. Returns 0 if there is none.
+            int remove(int id);
+
+            /// Returns the sample of a node or nullptr.
+            const Sample* get(int id) const;
+
+            const std::unordered_map<int,Sample>& getSamples() const {
+                return this->samples;
+            }
+
+            double getMaxTime() const {return this->maxTime;};
+            double getMaxMemory() const {return this->maxMemory;};
+
+            /// Returns the ids of the n nodes with the longest execution
+            /// times in descending order.
+            std::vector<int> getTopOffenders(size_t n) const;
+
+            static std::string formatTime(double seconds);
+            static std::string formatMemory(double bytes);
+
+        private:
+            int updateMaxima();
+
+            std::unordered_map<int,Sample> samples;
+            double maxTime{0};
+            double maxMemory{0};
+            unsigned int run{0};
+    };
+}
@@ -3,166 +3,181 @@
 // node editor includes
 #include <Node.h>
 #include <Edge.h>
+#include <EdgeLayer.h>
+#include <Graph.h>
+#include <Layout.h>
 #include <Utils.h>
 
 // qt includes
 #include <QPainter>
 
-// paraview/vtk includes
-#include <pqPipelineSource.h>
-#include <pqView.h>
-
 // std includes
-#include <sstream>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+#if NE_ENABLE_GRAPHVIZ
+#include <GraphvizModel.h>
+#endif
 
 NE::Scene::Scene(QObject* parent) : QGraphicsScene(parent){
+    for(int type=0; type<2; type++){
+        this->edgeLayers[type] = new NE::EdgeLayer(type);
+        this->addItem(this->edgeLayers[type]);
+    }
+
+#if NE_ENABLE_GRAPHVIZ
+    if(NE::CONSTS::LAYOUT_USE_GRAPHVIZ)
+        this->graphvizModel = new NE::GraphvizModel();
+#endif
 }
 
 NE::Scene::~Scene(){
-}
+    // remaining nodes return their ports to the pool when they are deleted,
+    // so they have to go before the pool
+    this->clear();
 
 #if NE_ENABLE_GRAPHVIZ
-#include <graphviz/cgraph.h>
-#include <graphviz/gvc.h>
+    delete this->graphvizModel;
 #endif
+}
 
-int NE::Scene::computeLayout(
-    std::unordered_map<int,NE::Node*>& nodes,
-    std::unordered_map<int,std::vector<NE::Edge*>>& edges
+int NE::Scene::computeGraphLayout(
+    const NE::LayoutGraph& graph,
+    NE::LayoutResult& result,
+    const std::atomic<bool>* cancelled
 ){
-    NE::log("Computing Graph Layout");
-
 #if NE_ENABLE_GRAPHVIZ
+    if(this->graphvizModel)
+        return this->graphvizModel->computeLayout(graph, result, cancelled);
+#endif
 
-    // compute dot string
-    qreal maxHeight = 0.0;
-    qreal maxY = 0;
-    qreal minY = 0;
-    std::string dotString;
-    {
-        std::stringstream nodeString;
-        std::stringstream edgeString;
-
-        for(auto it : nodes){
-            auto proxyAsView = dynamic_cast<pqView*>(it.second->getProxy());
-            if(proxyAsView)
-                continue;
+    return NE::computeComponentLayout(graph, result, cancelled);
+}
 
-            const auto& b = it.second->boundingRect();
-            qreal width = b.width()/100.0;
-            qreal height = b.height()/100.0;
-            if(maxHeight<height)
-                maxHeight=height;
-
-            nodeString
-                << NE::getID(it.second->getProxy())
-                << "["
-                << "label=\"\","
-                << "shape=box,"
-                << "width="<<width<<","
-                << "height="<<height<<""
-                <<"];\n";
-
-            for(auto edge : edges[ NE::getID(it.second->getProxy()) ]){
-                edgeString
-                    << NE::getID(edge->getProducer()->getProxy())
-                    << " -> "
-                    << NE::getID(edge->getConsumer()->getProxy())
-                    << ";\n";
-            }
-        }
+bool NE::Scene::usesGraphviz(){
+    return this->graphvizModel!=nullptr;
+}
 
-        dotString += std::string("")
-            + "digraph g {\n"
-            + "rankdir=LR;graph[pad=\"0\", ranksep=\"2\", nodesep=\""+std::to_string(maxHeight)+"\"];\n"
-            + nodeString.str()
-            + edgeString.str()
-            + "\n}"
-        ;
-        // NE::log(dotString);
-    }
+int NE::Scene::addLayoutNode(int id, qreal width, qreal height){
+#if NE_ENABLE_GRAPHVIZ
+    if(this->graphvizModel)
+        return this->graphvizModel->addNode(id, width, height);
+#endif
+    return 0;
+}
 
-    std::vector<qreal> coords(2*nodes.size(),0.0);
-    // compute layout
-    {
-        Agraph_t *G = agmemread(
-            dotString.data()
-        );
-        GVC_t *gvc = gvContext();
-        gvLayout(gvc, G, "dot");
+int NE::Scene::removeLayoutNode(int id){
+#if NE_ENABLE_GRAPHVIZ
+    if(this->graphvizModel)
+        return this->graphvizModel->removeNode(id);
+#endif
+    return 0;
+}
 
-        // read layout
-        int i=-2;
-        for(auto it : nodes){
-            i+=2;
+int NE::Scene::resizeLayoutNode(int id, qreal width, qreal height){
+#if NE_ENABLE_GRAPHVIZ
+    if(this->graphvizModel)
+        return this->graphvizModel->resizeNode(id, width, height);
+#endif
+    return 0;
+}
 
-            auto proxy = it.second->getProxy();
+int NE::Scene::setLayoutEdges(int id, const std::vector<int>& producers){
+#if NE_ENABLE_GRAPHVIZ
+    if(this->graphvizModel)
+        return this->graphvizModel->setIncomingEdges(id, producers);
+#endif
+    return 0;
+}
 
-            auto proxyAsView = dynamic_cast<pqView*>(proxy);
-            if(proxyAsView)
-                continue;
+NE::LayoutGraph NE::Scene::createLayoutGraph(const NE::Graph& pipeline){
+    // collect sources/filters ordered by id
+    std::vector<int> ids(pipeline.getSources().begin(), pipeline.getSources().end());
+    ids.insert(ids.end(), pipeline.getFilters().begin(), pipeline.getFilters().end());
+    std::sort(ids.begin(), ids.end());
 
-            Agnode_t *n = agnode(G, const_cast<char *>(std::to_string( NE::getID(proxy) ).data()), 0);
-            if(n != nullptr) {
-                auto &coord = ND_coord(n);
+    NE::LayoutGraph graph;
+#if NE_ENABLE_GRAPHVIZ
+    if(this->graphvizModel)
+        graph.revision = this->graphvizModel->getRevision();
+#endif
+    std::unordered_map<int,int> indices;
+    for(auto id : ids){
+        const auto b = pipeline.getNode(id)->boundingRect();
+        indices[id] = graph.nodes.size();
+        graph.nodes.push_back({ id, b.width(), b.height() });
+    }
 
-                coords[i] = coord.x;
-                coords[i+1] = coord.y;
+    for(auto id : pipeline.getFilters()){
+        for(auto producerId : pipeline.getProducers(id)){
+            auto producerIt = indices.find(producerId);
+            if(producerIt!=indices.end())
+                graph.edges.push_back({ producerIt->second, indices[id] });
+        }
+    }
 
-                if(minY>coord.y)
-                    minY=coord.y;
+    return graph;
+}
 
-                if(maxY<coord.y)
-                    maxY=coord.y;
-            }
-        }
+int NE::Scene::computeLayout(const NE::Graph& pipeline){
+    NE::log("Computing Graph Layout");
 
-        // free memory
-        gvFreeLayout(gvc, G);
-        agclose(G);
-        gvFreeContext(gvc);
-    }
+    const auto graph = this->createLayoutGraph(pipeline);
 
-    // set positions
-    {
-        int i=-2;
-        for(auto it : nodes){
-            i+=2;
+    NE::LayoutResult result;
+    this->computeGraphLayout(graph, result);
 
-            auto proxyAsView = dynamic_cast<pqView*>(it.second->getProxy());
-            if(proxyAsView)
-                continue;
+    return this->applyLayout(pipeline, graph, result);
+}
 
-            it.second->setPos(
-                coords[i],
-                coords[i+1]-minY
-            );
+int NE::Scene::applyLayout(
+    const NE::Graph& pipeline,
+    const NE::LayoutGraph& graph,
+    const NE::LayoutResult& result
+){
+    // set positions of nodes that still exist and were not moved by hand
+    qreal maxY = 0.0;
+    std::vector<NE::Node*> pinnedNodes;
+    for(size_t i=0; i<graph.nodes.size(); i++){
+        auto node = pipeline.getNode(graph.nodes[i].id);
+        if(!node)
+            continue;
+        if(node->isPinned()){
+            pinnedNodes.push_back(node);
+            continue;
         }
+
+        const auto b = node->boundingRect();
+        node->setPos(
+            result[i].first - b.left(),
+            result[i].second - b.top()
+        );
+        maxY = std::max(maxY, result[i].second + b.height());
     }
+    for(auto node : pinnedNodes)
+        this->pushCollidingNodes(node);
+
+    // collect views ordered by id
+    std::vector<int> viewIds(pipeline.getViews().begin(), pipeline.getViews().end());
+    std::sort(viewIds.begin(), viewIds.end());
 
     // compute initial x position for all views
     std::vector<std::pair<Node*,qreal>> viewXMap;
-    for(auto it : nodes){
-        auto proxyAsView = dynamic_cast<pqView*>(it.second->getProxy());
-        if(!proxyAsView)
-            continue;
-
+    for(auto id : viewIds){
         qreal avgX = 0;
-        auto edgesIt = edges.find( NE::getID(proxyAsView) );
-        if(edgesIt!=edges.end()){
-            int nEdges = edgesIt->second.size();
-            if(nEdges>0){
-                for(auto edge: edgesIt->second)
-                    avgX += edge->getProducer()->pos().x();
-                avgX /= nEdges;
-            }
+        const auto incomingEdges = pipeline.getIncomingEdges(id);
+        if(incomingEdges.size()>0){
+            for(auto edge: incomingEdges)
+                avgX += edge->getProducer()->pos().x();
+            avgX /= incomingEdges.size();
         }
 
-        viewXMap.emplace_back(it.second,avgX);
+        viewXMap.emplace_back(pipeline.getNode(id),avgX);
     }
 
     // sort views by current x coord
-    std::sort(
+    std::stable_sort(
         viewXMap.begin(),
         viewXMap.end(),
         [](const std::pair<Node*,qreal>& a, const std::pair<Node*,qreal>& b){
@@ -171,24 +186,176 @@ int NE::Scene::computeLayout(
     );
 
     // make sure all views have enough space
-    qreal lastX = 0.0;
+    qreal lastX = -999999;
     for(auto it: viewXMap){
-        const qreal width = it.first->boundingRect().width();
+        const auto b = it.first->boundingRect();
         qreal x = it.second;
-        if(lastX+width>x)
-            x = lastX+width + 10.0;
-        it.first->setPos( x, maxY + maxHeight*100.0 + 10.0 );
+        if(lastX+b.width()>x)
+            x = lastX+b.width() + NE::CONSTS::LAYOUT_NODE_SEPARATION;
+        it.first->setPos( x, maxY + NE::CONSTS::LAYOUT_RANK_SEPARATION - b.top() );
         lastX = x;
     }
 
     return 1;
-#else
-    NE::log("ERROR: GraphViz support disabled!",true);
+}
+
+int NE::Scene::computeIncrementalLayout(
+    const NE::Graph& pipeline,
+    std::unordered_set<int>& placedNodes,
+    std::unordered_set<int>& resizedNodes,
+    double deadline
+){
+    NE::log("Computing Incremental Graph Layout");
+
+    // compute the depth of placed nodes with respect to other placed nodes
+    std::unordered_map<int,int> depths;
+    std::function<int(int)> computeDepth = [&](int id){
+        auto depthIt = depths.find(id);
+        if(depthIt!=depths.end())
+            return depthIt->second;
+
+        depths[id] = 0; // guard against cycles
+        int depth = 0;
+        for(auto producerId : pipeline.getProducers(id))
+            if(placedNodes.count(producerId))
+                depth = std::max(depth, computeDepth(producerId)+1);
+
+        depths[id] = depth;
+        return depth;
+    };
+
+    // place producers before their consumers
+    std::vector<std::pair<int,int>> order;
+    for(auto id : placedNodes)
+        if(pipeline.getNode(id))
+            order.emplace_back(computeDepth(id), id);
+    std::sort(order.begin(), order.end());
+
+    const qreal rankSeparation = NE::CONSTS::LAYOUT_RANK_SEPARATION;
+    const qreal nodeSeparation = NE::CONSTS::LAYOUT_NODE_SEPARATION;
+
+    // every pass handles at least one node, so a pre-pass that alone
+    // exceeds the budget cannot stall the layout
+    bool progressed = false;
+
+    for(auto it : order){
+        if(progressed && NE::getTimeStamp()>deadline)
+            return 0;
+        progressed = true;
+
+        placedNodes.erase(it.second);
+
+        auto node = pipeline.getNode(it.second);
+        if(node->isPinned())
+            continue;
+
+        const auto incomingEdges = pipeline.getIncomingEdges(it.second);
+        if(incomingEdges.size()<1){
+            this->fitNode(node);
+            continue;
+        }
+
+        const auto offset = node->pos() - node->sceneBoundingRect().topLeft();
+
+        if(pipeline.getKind(it.second)==NE::Graph::VIEW){
+            // views are placed below their producers
+            qreal avgX = 0;
+            qreal maxY = -999999;
+            for(auto edge : incomingEdges){
+                auto producer = edge->getProducer();
+                avgX += producer->pos().x();
+                maxY = std::max(maxY, producer->sceneBoundingRect().bottom());
+            }
+            avgX /= incomingEdges.size();
+
+            node->setPos( avgX, maxY + nodeSeparation + offset.y() );
+        } else {
+            // filters are placed right of their producers
+            qreal maxX = -999999;
+            qreal avgY = 0;
+            for(auto edge : incomingEdges){
+                const auto b = edge->getProducer()->sceneBoundingRect();
+                maxX = std::max(maxX, b.right());
+                avgY += b.top();
+            }
+            avgY /= incomingEdges.size();
+
+            node->setPos( maxX + rankSeparation + offset.x(), avgY + offset.y() );
+        }
+
+        this->fitNode(node);
+    }
+
+    // nodes that no longer exist are dropped
+    placedNodes.clear();
+
+    while(resizedNodes.size()>0){
+        if(progressed && NE::getTimeStamp()>deadline)
+            return 0;
+        progressed = true;
+
+        const int id = *resizedNodes.begin();
+        resizedNodes.erase(resizedNodes.begin());
+
+        if(auto node = pipeline.getNode(id))
+            this->pushCollidingNodes(node);
+    }
+
+    return 1;
+}
+
+std::vector<NE::Node*> NE::Scene::getCollidingNodes(NE::Node* node){
+    const qreal padding = 0.5*NE::CONSTS::LAYOUT_NODE_SEPARATION;
+    const auto rect = node->sceneBoundingRect().adjusted(-padding,-padding,padding,padding);
+
+    std::vector<NE::Node*> collidingNodes;
+    for(auto item : this->items(rect)){
+        auto other = dynamic_cast<NE::Node*>(item);
+        if(other && other!=node)
+            collidingNodes.push_back(other);
+    }
+
+    return collidingNodes;
+}
+
+int NE::Scene::fitNode(NE::Node* node){
+    // every iteration moves the node further down, so only few are needed
+    for(int i=0; i<64; i++){
+        auto collidingNodes = this->getCollidingNodes(node);
+        if(collidingNodes.size()<1)
+            return 1;
+
+        const qreal top = node->sceneBoundingRect().top();
+        qreal maxY = top;
+        for(auto other : collidingNodes)
+            maxY = std::max(maxY, other->sceneBoundingRect().bottom());
+
+        node->moveBy(0, maxY + NE::CONSTS::LAYOUT_NODE_SEPARATION - top);
+    }
+
     return 0;
-#endif
 }
 
-QRect NE::Scene::getBoundingRect(std::unordered_map<int,NE::Node*>& nodes){
+int NE::Scene::pushCollidingNodes(NE::Node* node){
+    std::vector<NE::Node*> queue{node};
+
+    // bound the cascade so that a resize never touches the whole graph
+    for(size_t i=0; i<queue.size() && i<256; i++){
+        const auto anchor = queue[i]->sceneBoundingRect();
+        for(auto other : this->getCollidingNodes(queue[i])){
+            const auto b = other->sceneBoundingRect();
+            if(other->isPinned() || b.top()<anchor.top())
+                continue;
+
+            other->moveBy(0, anchor.bottom() + NE::CONSTS::LAYOUT_NODE_SEPARATION - b.top());
+            queue.push_back(other);
+        }
+    }
+
+    return 1;
+}
+
+QRect NE::Scene::getBoundingRect(const std::unordered_map<int,NE::Node*>& nodes){
     int x0 = 999999;
     int x1 = -999999;
     int y0 = 999999;
@@ -211,19 +378,46 @@ QRect NE::Scene::getBoundingRect(std::unordered_map<int,NE::Node*>& nodes){
 }
 
 void NE::Scene::drawBackground(QPainter *painter, const QRectF &rect){
-    const int gridSize = 25;
-
-    qreal left = int(rect.left()) - (int(rect.left()) % gridSize);
-    qreal top = int(rect.top()) - (int(rect.top()) % gridSize);
+    const qreal scale = painter->worldTransform().m11();
+    if(scale<NE::CONSTS::GRID_MIN_SCALE)
+        return;
+
+    // double the grid size until cells are large enough on screen
+    qreal gridSize = NE::CONSTS::GRID_SIZE;
+    while(gridSize*scale<NE::CONSTS::GRID_MIN_SPACING)
+        gridSize *= 2;
+
+    const int cells = 8;
+    const qreal tileSize = cells*gridSize;
+    const int tilePixels = std::max(cells, qRound(tileSize*scale));
+
+    // render the tile at device resolution
+    if(this->gridTile.isNull() || this->gridTileSize!=tileSize || this->gridTile.width()!=tilePixels){
+        QPixmap tile(tilePixels, tilePixels);
+        tile.fill(Qt::transparent);
+
+        QPainter tilePainter(&tile);
+        tilePainter.setPen( QColor(60,60,60) );
+        for(int i=0; i<cells; i++){
+            const int p = qRound(i*qreal(tilePixels)/cells);
+            tilePainter.drawLine(p, 0, p, tilePixels-1);
+            tilePainter.drawLine(0, p, tilePixels-1, p);
+        }
+        tilePainter.end();
 
-    QVarLengthArray<QLineF, 100> lines;
+        tile.setDevicePixelRatio(tilePixels/tileSize);
+        this->gridTile = tile;
+        this->gridTileSize = tileSize;
+    }
 
-    for (qreal x = left; x < rect.right(); x += gridSize)
-        lines.append(QLineF(x, rect.top(), x, rect.bottom()));
-    for (qreal y = top; y < rect.bottom(); y += gridSize)
-        lines.append(QLineF(rect.left(), y, rect.right(), y));
+    // align the tiles with the scene origin
+    qreal x = std::fmod(rect.left(), tileSize);
+    qreal y = std::fmod(rect.top(), tileSize);
+    if(x<0)
+        x += tileSize;
+    if(y<0)
+        y += tileSize;
 
-    painter->setRenderHints(QPainter::HighQualityAntialiasing);
-    painter->setPen( QColor(60,60,60) );
-    painter->drawLines(lines.data(), lines.size());
+    painter->setRenderHint(QPainter::SmoothPixmapTransform, false);
+    painter->drawTiledPixmap(rect, this->gridTile, QPointF(x,y));
 }
\ No newline at end of file
@@ -1,14 +1,24 @@
 #pragma once
 
+// node editor includes
+#include <Layout.h>
+#include <Port.h>
+
 // qt includes
 #include <QGraphicsScene>
+#include <QPixmap>
 
 // std includes
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace NE {
     class Node;
     class Edge;
+    class EdgeLayer;
+    class Graph;
+    class GraphvizModel;
 }
 
 namespace NE {
@@ -25,18 +35,95 @@ namespace NE {
             Scene(QObject* parent=nullptr);
             ~Scene();
 
-            QRect getBoundingRect(std::unordered_map<int,NE::Node*>& nodes);
+            QRect getBoundingRect(const std::unordered_map<int,NE::Node*>& nodes);
+
+            /// Returns the layer that draws all edges of a type
+            /// (0: pipeline edge, 1: view edge).
+            NE::EdgeLayer* getEdgeLayer(int type){
+                return this->edgeLayers[type>0 ? 1 : 0];
+            }
+
+            /// Returns the ports of deleted nodes that new nodes reuse.
+            NE::PortPool& getPortPool(){
+                return this->portPool;
+            }
+
+            /// Creates an immutable snapshot of the sizes and edges of all
+            /// source and filter nodes that can be laid out on any thread.
+            NE::LayoutGraph createLayoutGraph(const NE::Graph& pipeline);
+
+            /// Computes the layout of a snapshot with the engine selected by
+            /// NE::CONSTS::LAYOUT_USE_GRAPHVIZ. The built-in engine lays out
+            /// connected components in parallel. This function does not access
+            /// any scene items and can therefore be called from any thread.
+            /// Returns 0 if the computation was aborted via *cancelled*.
+            int computeGraphLayout(
+                const NE::LayoutGraph& graph,
+                NE::LayoutResult& result,
+                const std::atomic<bool>* cancelled = nullptr
+            );
+
+            /// Returns true if layouts are computed with the GraphViz model.
+            bool usesGraphviz();
+
+            /// Keep the persistent GraphViz model in sync with the pipeline.
+            /// These functions do nothing if GraphViz is not used.
+            int addLayoutNode(int id, qreal width, qreal height);
+            int removeLayoutNode(int id);
+            int resizeLayoutNode(int id, qreal width, qreal height);
+            int setLayoutEdges(int id, const std::vector<int>& producers);
+
+            /// Moves all nodes of a snapshot that still exist to the computed
+            /// positions and places the views below them.
+            int applyLayout(
+                const NE::Graph& pipeline,
+                const NE::LayoutGraph& graph,
+                const NE::LayoutResult& result
+            );
 
         public slots:
-            int computeLayout(
-                std::unordered_map<int,NE::Node*>& nodes,
-                std::unordered_map<int,std::vector<NE::Edge*>>& edges
+            /// Synchronously computes and applies a full layout.
+            int computeLayout(const NE::Graph& pipeline);
+
+            /// Updates the layout only in the neighborhood of the given nodes.
+            /// Nodes in *placedNodes* (created or rewired) are positioned
+            /// next to their producers, and nodes in *resizedNodes* push
+            /// overlapping nodes out of the way. All other nodes, and nodes
+            /// that were moved by hand, keep their positions. Processed nodes
+            /// are removed from both sets, and the update stops once the
+            /// *deadline* timestamp has passed. Returns 1 if all nodes were
+            /// processed.
+            int computeIncrementalLayout(
+                const NE::Graph& pipeline,
+                std::unordered_set<int>& placedNodes,
+                std::unordered_set<int>& resizedNodes,
+                double deadline
             );
 
         protected:
 
-            /// Draws a grid background.
-            void drawBackground(QPainter *painter, const QRectF &rect);
+            /// Moves a node down until it no longer overlaps other nodes.
+            int fitNode(NE::Node* node);
+
+            /// Moves all unpinned nodes that overlap the given node below it.
+            int pushCollidingNodes(NE::Node* node);
+
+            /// Returns all nodes that overlap the given node.
+            std::vector<NE::Node*> getCollidingNodes(NE::Node* node);
+
+            /// Draws a grid background from a cached tile. The grid gets
+            /// coarser when zooming out and disappears below GRID_MIN_SCALE.
+            void drawBackground(QPainter *painter, const QRectF &rect) override;
+
+        private:
+            NE::GraphvizModel* graphvizModel{nullptr};
+            NE::EdgeLayer* edgeLayers[2];
+            NE::PortPool portPool;
+
+            /// Pre-rendered tile of the background grid and its size in
+            /// scene coordinates.
+            QPixmap gridTile;
+            qreal gridTileSize{0};
     };
 
 }
\ No newline at end of file
@@ -27,9 +27,31 @@ int    NE::CONSTS::NODE_WIDTH = 300;
 int    NE::CONSTS::NODE_BORDER_WIDTH = 4;
 int    NE::CONSTS::NODE_BORDER_RADIUS = 6;
 int    NE::CONSTS::NODE_DEFAULT_VERBOSITY = 1;
+int    NE::CONSTS::NODE_PLACEHOLDER_HEIGHT = 120;
+int    NE::CONSTS::NODE_PROPERTY_HEIGHT = 30;
+int    NE::CONSTS::NODE_WIDGET_POOL_SIZE = 32;
+int    NE::CONSTS::PORT_POOL_SIZE = 256;
+int    NE::CONSTS::PROFILE_TOP_COUNT = 5;
+int    NE::CONSTS::MEMORY_THRESHOLD = 512; // MiB
 int    NE::CONSTS::EDGE_WIDTH = 5;
+int    NE::CONSTS::GRID_SIZE = 25;
+int    NE::CONSTS::GRID_MIN_SPACING = 8;
+double NE::CONSTS::GRID_MIN_SCALE = 0.2;
+int    NE::CONSTS::LAYOUT_RANK_SEPARATION = 150;
+int    NE::CONSTS::LAYOUT_NODE_SEPARATION = 30;
+double NE::CONSTS::LAYOUT_TIME_BUDGET = 0.016;
+#if NE_ENABLE_GRAPHVIZ
+bool   NE::CONSTS::LAYOUT_USE_GRAPHVIZ = true;
+#else
+bool   NE::CONSTS::LAYOUT_USE_GRAPHVIZ = false;
+#endif
+int    NE::CONSTS::LAYOUT_CACHE_CAPACITY = 100000;
+double NE::CONSTS::LAYOUT_CACHE_QUANTIZATION = 8.0;
+double NE::CONSTS::LOD_REDUCED_SCALE = 0.6;
+double NE::CONSTS::LOD_MINIMAL_SCALE = 0.3;
 QColor NE::CONSTS::COLOR_ORANGE = QColor("#e9763d");
 QColor NE::CONSTS::COLOR_GREEN  = QColor("#049a0a");
+QColor NE::CONSTS::COLOR_RED    = QColor("#d62728");
 double NE::CONSTS::DOUBLE_CLICK_DELAY = 0.3;
 
 void NE::log(std::string content, bool force){
@@ -55,6 +77,19 @@ std::string NE::getLabel(pqProxy* proxy){
     return proxy->getSMName().toStdString() + "<" + std::to_string(NE::getID(proxy)) + ">";
 };
 
+int NE::removeInterceptors(QObject* object){
+    // copy the list, since deleting a child modifies it
+    const auto children = object->children();
+    for(auto child : children){
+        auto interceptor = dynamic_cast<NE::InterceptorBase*>(child);
+        if(!interceptor)
+            continue;
+        object->removeEventFilter(interceptor);
+        delete interceptor;
+    }
+    return 1;
+};
+
 double NE::getTimeStamp(){
     #ifdef _WIN32
         LARGE_INTEGER frequency;
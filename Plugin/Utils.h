@@ -20,17 +20,42 @@ namespace NE {
         extern int    NODE_BORDER_RADIUS;
         extern int    NODE_BR_PADDING;
         extern int    NODE_DEFAULT_VERBOSITY;
+        extern int    NODE_PLACEHOLDER_HEIGHT;
+        extern int    NODE_PROPERTY_HEIGHT;
+        extern int    NODE_WIDGET_POOL_SIZE;
+        extern int    PORT_POOL_SIZE;
+        extern int    PROFILE_TOP_COUNT;
+        extern int    MEMORY_THRESHOLD;
         extern int    EDGE_WIDTH;
+        extern int    GRID_SIZE;
+        extern int    GRID_MIN_SPACING;
+        extern double GRID_MIN_SCALE;
+        extern int    LAYOUT_RANK_SEPARATION;
+        extern int    LAYOUT_NODE_SEPARATION;
+        extern double LAYOUT_TIME_BUDGET;
+        extern bool   LAYOUT_USE_GRAPHVIZ;
+        extern int    LAYOUT_CACHE_CAPACITY;
+        extern double LAYOUT_CACHE_QUANTIZATION;
+        extern double LOD_REDUCED_SCALE;
+        extern double LOD_MINIMAL_SCALE;
         extern QColor COLOR_ORANGE;
         extern QColor COLOR_GREEN;
+        extern QColor COLOR_RED;
         extern double DOUBLE_CLICK_DELAY;
     };
 
+    /// Common base of all interceptors, so that they can be found among the
+    /// children of the object they filter.
+    class InterceptorBase : public QObject {
+        public:
+            InterceptorBase(QObject* parent) : QObject(parent){}
+    };
+
     template<typename F>
-    class Interceptor : public QObject {
+    class Interceptor : public InterceptorBase {
         public:
             F functor;
-            Interceptor(QObject* parent,F functor) : QObject(parent), functor(functor){}
+            Interceptor(QObject* parent,F functor) : InterceptorBase(parent), functor(functor){}
             ~Interceptor(){
             }
 
@@ -44,6 +69,9 @@ namespace NE {
         return new Interceptor<F>(parent, functor);
     };
 
+    /// Uninstalls and deletes all interceptors that are children of an object.
+    int removeInterceptors(QObject* object);
+
     double getTimeDelta();
     double getTimeStamp();
 
@@ -4,8 +4,17 @@
 #include <QWheelEvent>
 #include <QKeyEvent>
 #include <QAction>
+#include <QTimer>
 #include <pqDeleteReaction.h>
 
+// node editor includes
+#include <Utils.h>
+#include <Node.h>
+
+// std includes
+#include <algorithm>
+#include <unordered_set>
+
 NE::View::View(QWidget* parent)
     : QGraphicsView(parent){
 };
@@ -18,6 +27,16 @@ NE::View::View(QGraphicsScene* scene, QWidget* parent)
     new pqDeleteReaction(this->deleteAction);
 
     this->setRenderHint(QPainter::Antialiasing);
+    this->setCacheMode(QGraphicsView::CacheBackground);
+
+    // track which nodes are visible
+    this->visibleNodesTimer = new QTimer(this);
+    this->visibleNodesTimer->setSingleShot(true);
+    this->visibleNodesTimer->setInterval(50);
+    QObject::connect(
+        this->visibleNodesTimer, &QTimer::timeout,
+        this, &View::updateVisibleNodes
+    );
 };
 
 NE::View::~View(){
@@ -35,8 +54,86 @@ void NE::View::wheelEvent(QWheelEvent *event){
     }
     scale(factor, factor);
     setTransformationAnchor(anchor);
+    this->resetCachedContent();
+
+    this->updateLevelOfDetail();
+    this->requestVisibleNodesUpdate();
 };
 
+void NE::View::resizeEvent(QResizeEvent *event){
+    QGraphicsView::resizeEvent(event);
+    this->requestVisibleNodesUpdate();
+}
+
+void NE::View::scrollContentsBy(int dx, int dy){
+    QGraphicsView::scrollContentsBy(dx, dy);
+    this->requestVisibleNodesUpdate();
+}
+
+int NE::View::requestVisibleNodesUpdate(){
+    if(!this->visibleNodesTimer || this->visibleNodesTimer->isActive())
+        return 0;
+    this->visibleNodesTimer->start();
+    return 1;
+}
+
+int NE::View::updateVisibleNodes(){
+    if(!this->scene())
+        return 0;
+
+    const auto rect = this->mapToScene(this->viewport()->rect()).boundingRect();
+
+    std::unordered_set<NE::Node*> nodes;
+    for(auto item: this->scene()->items(rect, Qt::IntersectsItemBoundingRect))
+        if(auto node = dynamic_cast<NE::Node*>(item))
+            nodes.insert(node);
+
+    for(auto& node: this->visibleNodes){
+        if(!node || nodes.count(node))
+            continue;
+        node->setVisibleInViewport(false);
+        if(node->getProxyProperties())
+            this->pooledNodes.push_front(node);
+    }
+
+    this->visibleNodes.clear();
+    for(auto node: nodes){
+        if(!node->isVisibleInViewport()){
+            node->setVisibleInViewport(true);
+            this->pooledNodes.remove(node);
+        }
+        this->visibleNodes.push_back(node);
+    }
+
+    // release the widgets of the least recently visible nodes
+    const size_t capacity = std::max(NE::CONSTS::NODE_WIDGET_POOL_SIZE,0);
+    auto it = this->pooledNodes.end();
+    while(this->pooledNodes.size()>capacity && it!=this->pooledNodes.begin()){
+        --it;
+        if(!*it || (*it)->releaseProxyProperties())
+            it = this->pooledNodes.erase(it);
+    }
+
+    return 1;
+}
+
+int NE::View::updateLevelOfDetail(){
+    const qreal scale = this->transform().m11();
+    const int level = scale<NE::CONSTS::LOD_MINIMAL_SCALE
+        ? 2
+        : scale<NE::CONSTS::LOD_REDUCED_SCALE
+            ? 1
+            : 0;
+
+    if(level==this->levelOfDetail)
+        return 0;
+
+    this->levelOfDetail = level;
+    emit this->levelOfDetailChanged(level);
+
+    return 1;
+}
+
 void NE::View::keyReleaseEvent(QKeyEvent *event){
     if(event->key()==Qt::Key_Delete)
         this->deleteAction->trigger();
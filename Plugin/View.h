@@ -2,26 +2,68 @@
 
 // qt includes
 #include <QGraphicsView>
+#include <QPointer>
+
+// std includes
+#include <list>
+#include <vector>
 
 // forward declarations
 class QWheelEvent;
 class QKeyEvent;
+class QResizeEvent;
 class QAction;
+class QTimer;
+
+namespace NE {
+    class Node;
+}
 
 namespace NE {
     // This class extends QGraphicsView to rehandle MouseWheelEvents for zooming.
     class View : public QGraphicsView {
+        Q_OBJECT
+
         public:
 
             View(QWidget* parent=nullptr);
             View(QGraphicsScene* scene, QWidget* parent=nullptr);
             ~View();
 
+            /// Returns the level of detail for the current zoom level
+            /// (0: full, 1: reduced, 2: minimal).
+            int getLevelOfDetail(){return this->levelOfDetail;};
+
+            /// Recomputes the level of detail from the view transform.
+            int updateLevelOfDetail();
+
+            /// Schedules an update of the nodes that intersect the viewport.
+            /// Multiple requests within one interval are coalesced. The view
+            /// requests updates when it is zoomed, scrolled or resized, and
+            /// the owner has to request them when nodes are added or moved.
+            int requestVisibleNodesUpdate();
+
+            /// Notifies all nodes that entered or left the viewport. Nodes
+            /// that left the viewport keep their property widgets in a pool
+            /// of at most NODE_WIDGET_POOL_SIZE nodes; the least recently
+            /// visible ones release their widgets once the pool is full.
+            int updateVisibleNodes();
+
+        signals:
+            void levelOfDetailChanged(int level);
+
         protected:
             void wheelEvent(QWheelEvent *event);
             void keyReleaseEvent(QKeyEvent *event);
+            void resizeEvent(QResizeEvent *event);
+            void scrollContentsBy(int dx, int dy);
 
         private:
             QAction* deleteAction{nullptr};
+            int levelOfDetail{0};
+
+            QTimer* visibleNodesTimer{nullptr};
+            std::vector<QPointer<NE::Node>> visibleNodes;
+            std::list<QPointer<NE::Node>> pooledNodes; // most recently visible first
     };
 }